@@ -1,474 +1,298 @@
 #include <iostream>
-#include <vector>
 #include <string>
 #include <cctype>
 #include <cstdlib>
-#include <map>
-
-enum Color { WHITE, BLACK, NONE };
-
-struct Piece
+#include <chrono>
+#include <cstring>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include <fstream>
+#include <sstream>
+#include "Search.h"
+#include "Pgn.h"
+
+std::string squareName(int x, int y)
 {
-    char type; // K, Q, R, B, N, P
-    Color color;
-    bool hasMoved;
-    Piece(char t = ' ', Color c = NONE) : type(t), color(c), hasMoved(false) {}
-};
+    return std::string(1, char('A' + y)) + char('0' + 8 - x);
+}
 
-class Board
+// Case-insensitive check that an input line starts with a command word, without copying the line
+bool startsWith(const char *line, size_t length, const char *word)
 {
+    size_t n = strlen(word);
+    if (length < n) return false;
+    for (size_t i = 0; i < n; ++i)
+        if (toupper((unsigned char)line[i]) != word[i]) return false;
+    return true;
+}
 
+class LineReader
+{
+    // Buffered stdin for scripted play: lines are handed out as views into one
+    // fixed buffer, so reading a move allocates nothing
 private:
-    std::vector<std::vector<Piece>> board;
-    std::pair<int, int> enPassantTarget = {-1, -1};
-
-public:
-    Board() : board(8, std::vector<Piece>(8))
-    {
-        setupBoard();
-    }
-
-    void setupBoard()
-    {
-        // Set up pieces
-        std::string backRank = "RNBQKBNR";
-        for (int i = 0; i < 8; ++i)
-        {
-            board[0][i] = Piece(backRank[i], BLACK);
-            board[1][i] = Piece('P', BLACK);
-            board[6][i] = Piece('P', WHITE);
-            board[7][i] = Piece(backRank[i], WHITE);
-        }
-    }
-
-    void display()
-    {
-        std::cout << "\n\n\n\n   A  B  C  D  E  F  G  H\n";
-        for (int i = 0; i < 8; ++i)
-        {
-            std::cout << 8 - i << " ";
-            for (int j = 0; j < 8; ++j)
-            {
-                Piece &p = board[i][j];
-                if (p.color == WHITE)
-                    std::cout << "[" << p.type << "]";
-                else if (p.color == BLACK)
-                    std::cout << "(" << p.type << ")";
-                else
-                    std::cout << " . ";
-            }
-            std::cout << " " << 8 - i << "\n";
-        }
-        std::cout << "   A  B  C  D  E  F  G  H\n";
-    }
+    char buffer[65536];
+    size_t start = 0, end = 0;
+    bool eof = false;
 
-    bool isInsideBoard(int x, int y)
+    long readMore(char *to, size_t size)
     {
-        return x >= 0 && x < 8 && y >= 0 && y < 8;
+        // A raw read returns what is available instead of waiting for a full buffer
+#ifdef _WIN32
+        return _read(0, to, (unsigned)size);
+#else
+        return read(0, to, size);
+#endif
     }
 
-    bool canPieceAttack(int sx, int sy, int ex, int ey, Piece &p)
+public:
+    bool next(const char *&line, size_t &length)
     {
-        // Check if piece can attack the target position (ex, ey)
-
-        // PAWN
-        if (p.type == 'P')
+        while (true)
         {
-            int dir = (p.color == WHITE) ? -1 : 1;
-            if (abs(sx - ex) == 1 && abs(sy - ey) == 1)
-            {
-                if (board[ex][ey].color != p.color && board[ex][ey].type != ' ')
-                {
-                    return true; // Pawn can capture diagonally
-                }
-            }
-        }
-
-        // KNIGHT
-        else if (p.type == 'N')
-        {
-            if ((abs(sx - ex) == 2 && abs(sy - ey) == 1) || (abs(sx - ex) == 1 && abs(sy - ey) == 2))
-            {
-                return true; // Knight's L-shaped move
-            }
-        }
-
-        // KING
-        else if (p.type == 'K')
-        {
-            if (abs(sx - ex) <= 1 && abs(sy - ey) <= 1)
-            {
-                return true; // King moves one square in any direction
-            }
-        }
-
-        // ROOK
-        else if (p.type == 'R')
-        {
-            if (sx != ex && sy != ey) return false;  // Rooks move only in straight lines
-
-            int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
-            int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
-
-            for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+            char *newline = (char *)memchr(buffer + start, '\n', end - start);
+            if (newline || eof || (start == 0 && end == sizeof(buffer)))
             {
-                if (board[x][y].type != ' ') return false;  // Blocked by another piece
+                // A full line, the last unterminated one, or one too long for the buffer
+                if (!newline && start == end) return false;
+                line = buffer + start;
+                length = (newline ? newline : buffer + end) - line;
+                start = newline ? (newline - buffer) + 1 : end;
+                if (length > 0 && line[length - 1] == '\r') --length;
+                return true;
             }
-            return true;
-        }
-
-        // BISHOP
-        else if (p.type == 'B')
-        {
-            if (abs(sx - ex) != abs(sy - ey)) return false;  // Bishops move diagonally
-
-            int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
-            int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
 
-            for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
-            {
-                if (board[x][y].type != ' ') return false;  // Blocked by another piece
-            }
-            return true;
+            memmove(buffer, buffer + start, end - start);
+            end -= start;
+            start = 0;
+            long n = readMore(buffer + end, sizeof(buffer) - end);
+            if (n <= 0) eof = true;
+            else end += n;
         }
+    }
+};
 
-        // QUEEN
-        else if (p.type == 'Q')
-        {
-            if (sx == ex || sy == ey)
-            {
-                // Horizontal or vertical movement like rook
-                int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
-                int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
-
-                for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
-                {
-                    if (board[x][y].type != ' ') return false;  // Blocked by another piece
-                }
-                return true;
-            } else if (abs(sx - ex) == abs(sy - ey))
-            {
-                // Diagonal movement like bishop
-                int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
-                int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
+const long long HINT_MS = 200;  // Latency budget for the hint command
 
-                for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
-                {
-                    if (board[x][y].type != ' ') return false;  // Blocked by another piece
-                }
-                return true;
-            }
-        }
+int main(int argc, char *argv[])
+{
 
-        return false; // Default return value
-    }
+    Board chessboard;
+    Color turn = WHITE;
+    std::string input;
 
-    bool isCheck(Color turn)
+    // Optional computer opponent: --engine white|black [--time sec] [--inc sec] [--ponder]
+    // Scripted play: --batch reads moves through LineReader and writes once per move,
+    // --no-board skips the board dump. --chess960 n starts from Chess960 setup n (0-959);
+    // castle there by moving the king onto its own rook.
+    Color engineColor = NONE;
+    long long engineTimeMs = 300000, incrementMs = 0;
+    bool ponderEnabled = false;
+    bool batch = false, showBoard = true;
+    for (int i = 1; i < argc; ++i)
     {
-        // Find the current player's king
-        std::pair<int, int> kingPos;
-        for (int i = 0; i < 8; ++i)
-        {
-            for (int j = 0; j < 8; ++j)
-            {
-                if (board[i][j].type == 'K' && board[i][j].color == turn)
-                {
-                    kingPos = {i, j};
-                    break;
-                }
-            }
-        }
-
-        // Check if any opposing piece can attack the king
-        for (int i = 0; i < 8; ++i)
-        {
-            for (int j = 0; j < 8; ++j)
-            {
-                Piece &p = board[i][j];
-                if (p.color == (turn == WHITE ? BLACK : WHITE))
-                {
-                    // Try every possible move of the piece and check if it can reach the king
-                    if (canPieceAttack(i, j, kingPos.first, kingPos.second, p))
-                    {
-                        return true;
-                    }
-                }
-            }
-        }
-
-        return false;
+        std::string arg = argv[i];
+        if (arg == "--engine" && i + 1 < argc) engineColor = (std::string(argv[++i]) == "white") ? WHITE : BLACK;
+        else if (arg == "--time" && i + 1 < argc) engineTimeMs = std::atoll(argv[++i]) * 1000;
+        else if (arg == "--inc" && i + 1 < argc) incrementMs = std::atoll(argv[++i]) * 1000;
+        else if (arg == "--ponder") ponderEnabled = true;
+        else if (arg == "--batch") batch = true;
+        else if (arg == "--no-board") showBoard = false;
+        else if (arg == "--chess960" && i + 1 < argc) chessboard.setupChess960(std::atoi(argv[++i]));
     }
 
-    bool movePiece(int sx, int sy, int ex, int ey, Color turn)
+    LineReader reader;
+    if (batch) std::ios::sync_with_stdio(false);
+
+    // Played moves as undo records, and undone moves waiting to be replayed
+    GameRecord record;
+    record.chess960 = chessboard.chess960;
+    if (chessboard.chess960) record.startFen = chessboard.toFen(WHITE);
+    std::vector<UndoRecord> history;
+    std::vector<Move> redo;
+    auto play = [&](const Move &m)
     {
-        Piece &p = board[sx][sy];
-        if (p.color != turn) return false;
+        UndoRecord undo;
+        if (!chessboard.makeMove(m, turn, undo)) return false;
+        history.push_back(undo);
+        turn = (turn == WHITE ? BLACK : WHITE);
+        return true;
+    };
 
-        Piece &target = board[ex][ey];
-        int dx = ex - sx, dy = ey - sy;
+    Search engine;
+    Ponder ponder(engine);
+    bool ponderHit = false;
+    std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
 
-        // Check if the move puts the king in check
-        Board tempBoard = *this;
-        tempBoard.board[ex][ey] = p;
-        tempBoard.board[sx][sy] = Piece();
-        if (tempBoard.isCheck(turn))
-        {
-            return false;  // Move would put the king in check
-        }
-        if (!isInsideBoard(ex, ey))
+    while (true)
+    {
+        if (showBoard) chessboard.display();
+        const PositionState &state = chessboard.positionState(turn);
+        if (state.result == CHECKMATE)
         {
-            return false;
+            std::cout << "C H E C K M A T E " << (turn == WHITE ? "...Black" : "...White") << " wins!\n";
+            break;
         }
-        if (target.color == turn)
+        if (state.result == STALEMATE)
         {
-            return false;
+            std::cout << "S T A L E M A T E ...Game over.\n";
+            break;
         }
 
-        // PAWN
-        if (p.type == 'P')
+        if (turn == engineColor)
         {
-            int dir = (p.color == WHITE) ? -1 : 1;
-
-            // Single forward move
-            if (dy == 0 && dx == dir && target.type == ' ')
+            Move m;
+            if (ponderHit)
             {
-                board[ex][ey] = p;
-                board[sx][sy] = Piece();
-            }
-            // Double forward move
-            else if (dy == 0 && dx == 2 * dir && sx == (p.color == WHITE ? 6 : 1) &&
-                     board[sx + dir][sy].type == ' ' && target.type == ' ')
+                m = ponder.finish();
+                ponderHit = false;
+            } else
             {
-                board[ex][ey] = p;
-                board[sx][sy] = Piece();
-                enPassantTarget = {sx + dir, sy};  // Set en passant target square
-            }
-            // Standard diagonal capture
-            else if (abs(dy) == 1 && dx == dir && target.color == (p.color == WHITE ? BLACK : WHITE))
-            {
-                board[ex][ey] = p;
-                board[sx][sy] = Piece();
-            }
-            // En passant capture
-            else if (abs(dy) == 1 && dx == dir && ex == enPassantTarget.first && ey == enPassantTarget.second)
-            {
-                board[ex][ey] = p;
-                board[sx][sy] = Piece();
-                board[sx][ey] = Piece();  // Capture the pawn behind
-            }
-            else
-            {
-                return false;  // Invalid pawn move
+                engine.timer.start(engineTimeMs, incrementMs);
+                m = engine.think(chessboard, turn, MAX_PLY);
             }
 
-            // Reset en passant if not double move
-            if (!(dy == 0 && dx == 2 * dir))
-            {
-                enPassantTarget = {-1, -1};
-            }
+            engineTimeMs -= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - clockStart).count();
+            engineTimeMs += incrementMs;
+            std::cout << "Engine plays " << squareName(m.sx, m.sy) << " " << squareName(m.ex, m.ey) << "\n";
+            play(m);
+            redo.clear();
 
-            // Promotion
-            if (ex == 0 || ex == 7)
+            // Think on the reply the engine expects while the opponent types
+            if (ponderEnabled && engine.bestLine.size() >= 2)
             {
-                char promote;
-                std::cout << "Promote to (Q, R, B, N): ";
-                std::cin >> promote;
-                board[ex][ey].type = toupper(promote);
+                Move reply = engine.bestLine[1];
+                Board predicted = chessboard;
+                if (predicted.movePiece(reply.sx, reply.sy, reply.ex, reply.ey, turn, reply.promotion))
+                    ponder.start(predicted, engineColor, reply);
             }
-
-            board[ex][ey].hasMoved = true;
-            return true;
-        }
-
-        // KNIGHT
-        else if (p.type == 'N')
-        {
-            if (!(abs(dx) == 2 && abs(dy) == 1) && !(abs(dx) == 1 && abs(dy) == 2)) return false;
+            continue;
         }
 
-        // KING
-        else if (p.type == 'K')
+        std::cout << (turn == WHITE ? "[ ] White" : "( ) Black") << " to move (e.g., E2 E4): ";
+        const char *line;
+        size_t length;
+        if (batch)
         {
-            if (abs(dy) == 2 && dx == 0 && !p.hasMoved)
-            {
-                // Castling
-                int rookY = (dy == 2) ? 7 : 0;
-                int dir = (dy > 0) ? 1 : -1;
-                for (int i = sy + dir; i != rookY; i += dir) if (board[sx][i].type != ' ') return false;
-                if (board[sx][rookY].type == 'R' && !board[sx][rookY].hasMoved)
-                {
-                    board[sx][sy + dir] = board[sx][rookY];
-                    board[sx][rookY] = Piece();
-                } else return false;
-            } else if (abs(dx) > 1 || abs(dy) > 1) return false;
-        }
-
-        // ROOK
-        else if (p.type == 'R')
+            std::cout.flush();  // Board and prompt leave in one write
+            if (!reader.next(line, length)) break;
+        } else
         {
-            if (dx != 0 && dy != 0) return false;
-            int stepX = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
-            int stepY = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
-            for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
-            {
-                if (board[x][y].type != ' ') return false;
-            }
+            if (!std::getline(std::cin, input)) break;
+            line = input.c_str();
+            length = input.length();
         }
 
-        // BISHOP
-        else if (p.type == 'B')
+        // "UNDO" / "REDO" step one move, or back to the human's turn against the engine
+        bool undoing = length == 4 && startsWith(line, length, "UNDO");
+        if (undoing || (length == 4 && startsWith(line, length, "REDO")))
         {
-            if (abs(dx) != abs(dy)) return false;
-            int stepX = (dx > 0) ? 1 : -1;
-            int stepY = (dy > 0) ? 1 : -1;
-            for (int x = sx + stepX, y = sy + stepY; x != ex; x += stepX, y += stepY)
+            ponder.cancel();
+            ponderHit = false;
+            if (undoing ? history.empty() : redo.empty())
             {
-                if (board[x][y].type != ' ') return false;
+                std::cout << (undoing ? "Nothing to undo.\n" : "Nothing to redo.\n");
+                continue;
             }
-        }
-
-        // QUEEN
-        else if (p.type == 'Q')
-        {
-            if (dx == 0 || dy == 0)
+            do
             {
-                int stepX = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
-                int stepY = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
-                for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+                if (undoing)
                 {
-                    if (board[x][y].type != ' ') return false;
-                }
-            } else if (abs(dx) == abs(dy))
-            {
-                int stepX = (dx > 0) ? 1 : -1;
-                int stepY = (dy > 0) ? 1 : -1;
-                for (int x = sx + stepX, y = sy + stepY; x != ex; x += stepX, y += stepY)
+                    chessboard.unmakeMove(history.back());
+                    redo.push_back(history.back().move);
+                    history.pop_back();
+                    turn = (turn == WHITE ? BLACK : WHITE);
+                } else
                 {
-                    if (board[x][y].type != ' ') return false;
+                    play(redo.back());
+                    redo.pop_back();
                 }
-            } else return false;
+            } while (turn == engineColor && !(undoing ? history.empty() : redo.empty()));
+            clockStart = std::chrono::steady_clock::now();
+            continue;
         }
 
-        // Execute move
-        board[ex][ey] = p;
-        board[ex][ey].hasMoved = true;
-        board[sx][sy] = Piece();
-        return true;
-    }
-
-    bool isCheckmate(Color turn)
-    {
-        if (!isCheck(turn)) return false;
-
-        for (int i = 0; i < 8; ++i)
+        // "SAVE game.pgn" / "LOAD game.pgn"
+        bool saving = startsWith(line, length, "SAVE ");
+        if (saving || startsWith(line, length, "LOAD "))
         {
-            for (int j = 0; j < 8; ++j)
+            std::string path(line + 5, length - 5);
+            if (saving)
             {
-                Piece &p = board[i][j];
-                if (p.color == turn)
-                {
-                    for (int x = 0; x < 8; ++x)
-                    {
-                        for (int y = 0; y < 8; ++y)
-                        {
-                            // Skip if trying to move to same square
-                            if (i == x && j == y) continue;
-
-                            // Create a temporary board
-                            Board temp = *this;
-
-                            // Make the move on the temp board
-                            if (temp.movePiece(i, j, x, y, turn))
-                            {
-                                // If king is safe after this move, not checkmate
-                                if (!temp.isCheck(turn))
-                                {
-                                    return false;
-                                }
-                            }
-                        }
-                    }
-                }
+                record.moves.clear();
+                for (UndoRecord &u : history) record.moves.push_back(u.move);
+                std::ofstream out(path);
+                out << writePgn(record);
+                std::cout << (out ? "Saved " : "Could not save ") << path << "\n";
+                continue;
             }
-        }
 
-        // No legal moves found that stop check
-        return true;
-    }
-
-    bool isStalemate(Color turn)
-    {
-        if (isCheck(turn)) return false;
-
-        for (int i = 0; i < 8; ++i)
-        {
-            for (int j = 0; j < 8; ++j)
+            std::ifstream in(path);
+            std::stringstream contents;
+            contents << in.rdbuf();
+            GameRecord loaded;
+            if (!in || !readPgn(contents.str(), loaded))
             {
-                Piece &p = board[i][j];
-                if (p.color == turn)
-                {
-                    for (int x = 0; x < 8; ++x)
-                    {
-                        for (int y = 0; y < 8; ++y)
-                        {
-                            // Skip if trying to move to same square
-                            if (i == x && j == y) continue;
-
-                            // Create a temporary board
-                            Board temp = *this;
-
-                            // Make the move on the temp board
-                            if (temp.movePiece(i, j, x, y, turn))
-                            {
-                                // If king is safe after this move, not stalemate
-                                if (!temp.isCheck(turn))
-                                {
-                                    return false;
-                                }
-                            }
-                        }
-                    }
-                }
+                std::cout << "Could not load " << path << "\n";
+                continue;
             }
+            ponder.cancel();
+            ponderHit = false;
+            record = loaded;
+            setupFromRecord(record, chessboard, turn);
+            history.clear();
+            redo.clear();
+            for (Move &m : record.moves) play(m);
+            std::cout << "Loaded " << record.moves.size() << " moves from " << path << "\n";
+            continue;
         }
 
-        // No legal moves left
-        return true;
-    }
-};
-
-int main()
-{
-
-    Board chessboard;
-    Color turn = WHITE;
-    std::string input;
-
-    while (true)
-    {
-        chessboard.display();
-        if (chessboard.isCheckmate(turn))
+        // "HINT": the best move a short search finds, within HINT_MS
+        if (length == 4 && startsWith(line, length, "HINT"))
         {
-            std::cout << "C H E C K M A T E " << (turn == WHITE ? "...Black" : "...White") << " wins!\n";
-            break;
+            Search hinter;
+            Board position = chessboard;
+            hinter.timer.startFixed(HINT_MS);
+            Move hint = hinter.think(position, turn, MAX_PLY);
+            if (hint.sx >= 0)
+                std::cout << "Hint: " << squareName(hint.sx, hint.sy) << " " << squareName(hint.ex, hint.ey)
+                          << (hint.promotion != ' ' ? std::string(1, hint.promotion) : "") << " (depth "
+                          << hinter.completedDepth << ", score " << hinter.bestScore << ")\n";
+            continue;
         }
-        if (chessboard.isStalemate(turn))
+
+        // "MOVES E2": every legal destination for the piece on E2
+        if (length == 8 && startsWith(line, length, "MOVES "))
         {
-            std::cout << "S T A L E M A T E ...Game over.\n";
-            break;
+            int x = 8 - (line[7] - '0'), y = toupper(line[6]) - 'A';
+            if (x < 0 || x >= 8 || y < 0 || y >= 8)
+            {
+                std::cout << "Invalid coordinates. Use squares between A1 and H8.\n";
+                continue;
+            }
+            std::vector<Move> moves = legalMoves(chessboard, turn, x, y);
+            std::cout << "Legal moves for " << squareName(x, y) << ":";
+            for (Move &m : moves)
+                if (m.promotion == ' ' || m.promotion == 'Q')  // One entry per promotion square
+                    std::cout << " " << squareName(m.ex, m.ey);
+            std::cout << (moves.empty() ? " none\n" : "\n");
+            continue;
         }
-        std::cout << (turn == WHITE ? "[ ] White" : "( ) Black") << " to move (e.g., E2 E4): ";
-        std::getline(std::cin, input);
-        if (input.length() != 5 || input[2] != ' ')
+
+        // "E2 E4", or "E7 E8Q" to name the promotion piece up front
+        if ((length != 5 && length != 6) || line[2] != ' ' || (length == 6 && (line[5] == '\0' || !strchr("QRBN", toupper(line[5])))))
         {
-            std::cout << "Invalid input format.\n";
+            std::cout << "Invalid input format. Use E2 E4, MOVES E2, HINT, UNDO, REDO, SAVE file or LOAD file.\n";
             continue;
         }
 
-        int sx = 8 - (input[1] - '0');
-        int sy = toupper(input[0]) - 'A';
-        int ex = 8 - (input[4] - '0');
-        int ey = toupper(input[3]) - 'A';
+        int sx = 8 - (line[1] - '0');
+        int sy = toupper(line[0]) - 'A';
+        int ex = 8 - (line[4] - '0');
+        int ey = toupper(line[3]) - 'A';
 
         if (sx < 0 || sx >= 8 || sy < 0 || sy >= 8 || ex < 0 || ex >= 8 || ey < 0 || ey >= 8)
         {
@@ -476,14 +300,29 @@ int main()
             continue;
         }
 
-        if (!chessboard.movePiece(sx, sy, ex, ey, turn))
+        // Batch mode never prompts for a promotion piece on stdin; the board itself never reads input
+        char promotion = (length == 6) ? toupper(line[5]) : (batch ? 'Q' : ' ');
+        // Read through a const view: the non-const pieceAt drops the attack caches
+        const Piece &mover = static_cast<const Board &>(chessboard).pieceAt(sx, sy);
+        if (promotion == ' ' && mover.type == 'P' && mover.color == turn && (ex == 0 || ex == 7))
+        {
+            std::cout << "Promote to (Q, R, B, N): ";
+            std::string answer;
+            std::getline(std::cin, answer);
+            promotion = answer.empty() ? 'X' : toupper(answer[0]);  // Anything but QRBN is refused as illegal
+        }
+        if (!play(Move(sx, sy, ex, ey, promotion)))
         {
             std::cout << "Invalid move, try again.\n";
         } else {
-            turn = (turn == WHITE ? BLACK : WHITE);
-
+            redo.clear();
+            // The engine's clock starts now, whether or not it guessed the reply
+            clockStart = std::chrono::steady_clock::now();
+            if (ponder.isRunning()) ponderHit = ponder.hit(history.back().move, engineTimeMs, incrementMs);
         }
 
     }
+    ponder.cancel();
+    std::cout.flush();
     return 0;
 }
@@ -0,0 +1,104 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Per-thread bump allocator for the temporary Boards made by legality checks and search.
+// Open a BoardArena scope and every Board copied inside it takes its rows from the
+// thread's arena; closing the scope gives all of it back in one step. Scopes nest like
+// the stack, so a search can open one per ply. Boards must not outlive their scope.
+
+class ArenaResource : public std::pmr::memory_resource
+{
+private:
+    std::vector<char> buffer;
+    size_t offset = 0;
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        size_t start = (offset + alignment - 1) & ~(alignment - 1);
+        if (start + bytes > buffer.size())
+        {
+            // Arena full: fall back to the heap rather than fail
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        offset = start + bytes;
+        return buffer.data() + start;
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        // Arena memory comes back when the scope closes; only overflow goes to the heap
+        char *c = static_cast<char *>(p);
+        if (c < buffer.data() || c >= buffer.data() + buffer.size())
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    static const size_t CAPACITY = 256 * 1024;  // About 200 Board copies
+
+    ArenaResource() : buffer(CAPACITY) {}
+
+    size_t mark()
+    {
+        return offset;
+    }
+
+    void release(size_t to)
+    {
+        offset = to;
+    }
+};
+
+struct ArenaState
+{
+    ArenaResource resource;
+    int depth = 0;  // Open BoardArena scopes on this thread
+};
+
+inline ArenaState &arenaState()
+{
+    static thread_local ArenaState state;
+    return state;
+}
+
+inline std::pmr::memory_resource *boardMemory()
+{
+    ArenaState &state = arenaState();
+    return state.depth > 0 ? static_cast<std::pmr::memory_resource *>(&state.resource) : std::pmr::new_delete_resource();
+}
+
+class BoardArena
+{
+private:
+    size_t saved;
+
+public:
+    BoardArena()
+    {
+        ArenaState &state = arenaState();
+        saved = state.resource.mark();
+        ++state.depth;
+    }
+
+    ~BoardArena()
+    {
+        ArenaState &state = arenaState();
+        state.resource.release(saved);
+        --state.depth;
+    }
+
+    BoardArena(const BoardArena &) = delete;
+    BoardArena &operator=(const BoardArena &) = delete;
+};
+
+#endif
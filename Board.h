@@ -0,0 +1,1338 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include "Profile.h"
+#include "Arena.h"
+
+enum Color { WHITE, BLACK, NONE };
+
+struct Piece
+{
+    char type; // K, Q, R, B, N, P
+    Color color;
+    bool hasMoved;
+    Piece(char t = ' ', Color c = NONE) : type(t), color(c), hasMoved(false) {}
+};
+
+const int MATE_SCORE = 100000;
+
+struct Move
+{
+    int sx, sy, ex, ey;
+    char promotion; // Q, R, B, N or ' ' for none
+    int score;      // Ordering score, higher is tried first
+    Move(int a = -1, int b = -1, int c = -1, int d = -1, char promo = ' ')
+        : sx(a), sy(b), ex(c), ey(d), promotion(promo), score(0) {}
+};
+
+inline int pieceValue(char type)
+{
+    switch (type)
+    {
+        case 'P': return 100;
+        case 'N': return 320;
+        case 'B': return 330;
+        case 'R': return 500;
+        case 'Q': return 900;
+        case 'K': return 20000;
+        default: return 0;
+    }
+}
+
+inline int pieceIndex(const Piece &p)
+{
+    // 0-5 for white K, Q, R, B, N, P and 6-11 for black
+    static const std::string order = "KQRBNP";
+    return (p.color == BLACK ? 6 : 0) + (int)order.find(p.type);
+}
+
+struct ZobristKeys
+{
+    // Fixed pseudo-random keys, so a hash means the same thing in every run and thread
+    unsigned long long pieces[12][64];
+    unsigned long long unmoved[64];    // King or rook that can still castle
+    unsigned long long enPassant[64];
+    unsigned long long blackToMove;
+
+    ZobristKeys()
+    {
+        unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+        auto next = [&seed]()
+        {
+            // xorshift64*
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            return seed * 0x2545F4914F6CDD1DULL;
+        };
+        for (auto &piece : pieces)
+            for (unsigned long long &key : piece) key = next();
+        for (unsigned long long &key : unmoved) key = next();
+        for (unsigned long long &key : enPassant) key = next();
+        blackToMove = next();
+    }
+};
+
+inline const ZobristKeys &zobristKeys()
+{
+    static const ZobristKeys keys;
+    return keys;
+}
+
+struct PackedPosition
+{
+    // 32-byte position record: an occupancy bit per square (row * 8 + col), then a 4-bit
+    // pieceIndex per occupied square in the same order, two to a byte, low nibble first
+    unsigned long long occupancy;
+    unsigned char pieces[16];
+    unsigned char flags;          // Bit 0 black to move, bits 1-4 castling rights K, Q, k, q
+                                  // (outermost rook on that side), bit 5 Chess960
+    unsigned char enPassant;      // Square index, 64 for none
+    unsigned char halfmoveClock;
+    signed char result;           // Training label: 1 white won, 0 draw, -1 black won
+    unsigned short fullmoveNumber;
+    short score;                  // Training label: evaluation for the side to move
+};
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition must stay 32 bytes");
+
+struct AttackMap
+{
+    // Squares attacked by the enemy of turn, bit (i * 8 + j). turn's king is lifted off the
+    // board first, so a square behind it on a slider's line counts as attacked too.
+    Color turn = NONE;  // Side it was computed for; NONE once the position changes
+    unsigned long long squares = 0;
+};
+
+struct UndoRecord
+{
+    // What one move changed: at most four squares (from, to, a pawn taken en passant,
+    // a castling rook's two squares) and the en passant target. Undoing puts them back.
+    Move move;
+    int count = 0;
+    signed char squares[4];  // row * 8 + col
+    Piece pieces[4];
+    std::pair<int, int> enPassantTarget;
+    AttackMap attacks;  // The position's attack map, handed back on undo
+};
+
+enum GameResult { IN_PROGRESS, CHECKMATE, STALEMATE };
+
+struct PositionState
+{
+    // Derived facts about one position for one side, bit (i * 8 + j) per square
+    Color turn = NONE;                // Side it was computed for; NONE once the position changes
+    unsigned long long checkers = 0;  // Enemy pieces giving check
+    unsigned long long pinned = 0;    // Own pieces pinned to their king
+    int legalMoves = 0;
+    GameResult result = IN_PROGRESS;
+};
+
+struct PieceGrid : std::pmr::vector<std::pmr::vector<Piece>>
+{
+    // The 8x8 rows. A copy takes its memory from the current BoardArena, if one is open.
+    typedef std::pmr::vector<std::pmr::vector<Piece>> Rows;
+
+    PieceGrid() : Rows(8, std::pmr::vector<Piece>(8), boardMemory()) {}
+    PieceGrid(const PieceGrid &other) : Rows(other, boardMemory()) {}
+    PieceGrid &operator=(const PieceGrid &other) = default;
+};
+
+class Board
+{
+
+private:
+    PieceGrid board;
+    PositionState state;
+    AttackMap attacks;
+    std::pair<int, int> enPassantTarget = {-1, -1};
+
+public:
+    // Chess960 rules for this game: castling is written as the king moving onto its own rook,
+    // and the king and rook end on the usual squares wherever they started
+    bool chess960 = false;
+
+    Board()
+    {
+        setupBoard();
+    }
+
+    void setupBoard(const std::string &backRank = "RNBQKBNR")
+    {
+        // Set up pieces
+        for (int i = 0; i < 8; ++i)
+        {
+            board[0][i] = Piece(backRank[i], BLACK);
+            board[1][i] = Piece('P', BLACK);
+            board[6][i] = Piece('P', WHITE);
+            board[7][i] = Piece(backRank[i], WHITE);
+        }
+    }
+
+    static std::string chess960BackRank(int index)
+    {
+        // Scharnagl numbering, 0-959; 518 is the standard setup
+        std::string rank(8, ' ');
+        index = ((index % 960) + 960) % 960;
+        rank[2 * (index % 4) + 1] = 'B';  // Light-squared bishop
+        index /= 4;
+        rank[2 * (index % 4)] = 'B';      // Dark-squared bishop
+        index /= 4;
+
+        // The rest go on the empty squares in order: queen, the two knights, then R K R
+        auto placeOnEmpty = [&rank](int nth, char type)
+        {
+            for (char &c : rank)
+                if (c == ' ' && nth-- == 0)
+                {
+                    c = type;
+                    return;
+                }
+        };
+        placeOnEmpty(index % 6, 'Q');
+        index /= 6;
+        static const int knights[10][2] = {{0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 2}, {1, 3}, {1, 4}, {2, 3}, {2, 4}, {3, 4}};
+        placeOnEmpty(knights[index][1], 'N');  // Second one first, so the first index still counts the same squares
+        placeOnEmpty(knights[index][0], 'N');
+        placeOnEmpty(0, 'R');
+        placeOnEmpty(0, 'K');
+        placeOnEmpty(0, 'R');
+        return rank;
+    }
+
+    void setupChess960(int index)
+    {
+        board = PieceGrid();
+        setupBoard(chess960BackRank(index));
+        enPassantTarget = {-1, -1};
+        chess960 = true;
+        invalidate();
+    }
+
+    int castlingRook(Color c, bool kingSide)
+    {
+        // Column of the unmoved rook this side may castle with, outermost first, or -1
+        int row = (c == WHITE) ? 7 : 0;
+        int king = -1;
+        for (int j = 0; j < 8; ++j)
+            if (board[row][j].type == 'K' && board[row][j].color == c && !board[row][j].hasMoved) king = j;
+        if (king < 0) return -1;
+        int step = kingSide ? -1 : 1;
+        for (int j = kingSide ? 7 : 0; j != king; j += step)
+            if (board[row][j].type == 'R' && board[row][j].color == c && !board[row][j].hasMoved) return j;
+        return -1;
+    }
+
+    bool loadFen(const std::string &fen, Color &turn)
+    {
+        // Placement, side to move, castling rights and en passant square; the clocks are ignored.
+        // Castling rights become hasMoved flags on the king and rooks, and decide chess960 afresh.
+        std::istringstream in(fen);
+        std::string placement, side = "w", castling = "-", ep = "-";
+        if (!(in >> placement)) return false;
+        in >> side >> castling >> ep;
+
+        PieceGrid parsed;
+        int row = 0, col = 0;
+        for (char c : placement)
+        {
+            if (c == '/')
+            {
+                if (col != 8) return false;
+                ++row;
+                col = 0;
+            }
+            else if (c >= '1' && c <= '8') col += c - '0';
+            else if (strchr("KQRBNPkqrbnp", c) && row < 8 && col < 8)
+            {
+                parsed[row][col] = Piece(toupper(c), isupper(c) ? WHITE : BLACK);
+                parsed[row][col].hasMoved = (toupper(c) == 'K' || toupper(c) == 'R');
+                ++col;
+            }
+            else return false;
+            if (col > 8) return false;
+        }
+        if (row != 7 || col != 8) return false;
+
+        // Kings and rooks that still have castling rights count as unmoved. KQkq mean the
+        // outermost rook on that side; a file letter (Shredder-FEN) names the rook for Chess960.
+        bool variant = false;
+        for (char flag : castling)
+        {
+            if (!isalpha(flag)) continue;
+            Color c = isupper(flag) ? WHITE : BLACK;
+            int row = (c == WHITE) ? 7 : 0, king = -1, rook = -1;
+            for (int j = 0; j < 8; ++j)
+                if (parsed[row][j].type == 'K' && parsed[row][j].color == c) king = j;
+            if (king < 0) continue;
+
+            char f = toupper(flag);
+            if (f == 'K' || f == 'Q')
+            {
+                int step = (f == 'K') ? -1 : 1;
+                for (int j = (f == 'K') ? 7 : 0; j != king && rook < 0; j += step)
+                    if (parsed[row][j].type == 'R' && parsed[row][j].color == c) rook = j;
+            }
+            else if (f >= 'A' && f <= 'H') rook = f - 'A';
+            if (rook < 0 || parsed[row][rook].type != 'R' || parsed[row][rook].color != c) continue;
+
+            parsed[row][king].hasMoved = false;
+            parsed[row][rook].hasMoved = false;
+            if (king != 4 || (rook != 0 && rook != 7)) variant = true;
+        }
+
+        board = parsed;
+        chess960 = variant;
+        enPassantTarget = {-1, -1};
+        if (ep.size() == 2 && ep[0] >= 'a' && ep[0] <= 'h' && (ep[1] == '3' || ep[1] == '6'))
+            enPassantTarget = {8 - (ep[1] - '0'), ep[0] - 'a'};
+        turn = (side == "b") ? BLACK : WHITE;
+        invalidate();
+        return true;
+    }
+
+    std::string toFen(Color turn)
+    {
+        std::string fen;
+        for (int i = 0; i < 8; ++i)
+        {
+            int empty = 0;
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color == NONE)
+                {
+                    ++empty;
+                    continue;
+                }
+                if (empty) fen += char('0' + empty);
+                empty = 0;
+                fen += (p.color == WHITE) ? p.type : char(tolower(p.type));
+            }
+            if (empty) fen += char('0' + empty);
+            if (i < 7) fen += '/';
+        }
+
+        fen += (turn == WHITE) ? " w " : " b ";
+        std::string castling;
+        for (int r = 0; r < 4; ++r)
+        {
+            // K, Q, k, q; Chess960 names the rook's file instead
+            Color c = (r < 2) ? WHITE : BLACK;
+            int rook = castlingRook(c, r % 2 == 0);
+            if (rook < 0) continue;
+            char flag = chess960 ? char('A' + rook) : (r % 2 == 0 ? 'K' : 'Q');
+            castling += (c == WHITE) ? flag : char(tolower(flag));
+        }
+        fen += castling.empty() ? "-" : castling;
+
+        // Only an en passant square the side to move could capture onto
+        int epRow = (turn == WHITE) ? 2 : 5;
+        if (enPassantTarget.first == epRow)
+            fen += std::string(" ") + char('a' + enPassantTarget.second) + char('0' + 8 - epRow);
+        else
+            fen += " -";
+        return fen + " 0 1";
+    }
+
+    bool pack(PackedPosition &out, Color turn, int halfmoveClock = 0, int fullmoveNumber = 1)
+    {
+        // Board keeps no clocks, so the caller supplies them. Fails on more than 32 pieces.
+        out = PackedPosition();
+        int count = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                const Piece &p = board[i][j];
+                if (p.color == NONE) continue;
+                if (count == 32) return false;
+                out.occupancy |= 1ULL << (i * 8 + j);
+                out.pieces[count / 2] |= pieceIndex(p) << (count % 2 * 4);
+                ++count;
+            }
+        }
+
+        out.flags = (turn == BLACK) ? 1 : 0;
+        for (int r = 0; r < 4; ++r)
+            if (castlingRook(r < 2 ? WHITE : BLACK, r % 2 == 0) >= 0) out.flags |= 2 << r;
+        if (chess960) out.flags |= 32;
+
+        out.enPassant = isInsideBoard(enPassantTarget.first, enPassantTarget.second)
+                            ? enPassantTarget.first * 8 + enPassantTarget.second : 64;
+        out.halfmoveClock = (unsigned char)std::min(halfmoveClock, 255);
+        out.fullmoveNumber = (unsigned short)std::max(1, std::min(fullmoveNumber, 65535));
+        return true;
+    }
+
+    bool unpack(const PackedPosition &in, Color &turn)
+    {
+        // Checked before anything is written, so the rows can be filled in place
+        int count = __builtin_popcountll(in.occupancy);
+        if (count > 32) return false;
+        for (int n = 0; n < count; ++n)
+            if ((in.pieces[n / 2] >> (n % 2 * 4) & 15) > 11) return false;
+
+        static const char types[6] = {'K', 'Q', 'R', 'B', 'N', 'P'};
+        int n = 0;
+        for (int sq = 0; sq < 64; ++sq)
+        {
+            Piece &p = board[sq / 8][sq % 8];
+            if (!(in.occupancy >> sq & 1))
+            {
+                p = Piece();
+                continue;
+            }
+            int code = in.pieces[n / 2] >> (n % 2 * 4) & 15;
+            ++n;
+            p = Piece(types[code % 6], code < 6 ? WHITE : BLACK);
+            p.hasMoved = (p.type == 'K' || p.type == 'R');
+        }
+
+        // Same reading of castling rights as KQkq in loadFen
+        for (int r = 0; r < 4; ++r)
+        {
+            if (!(in.flags & (2 << r))) continue;
+            Color c = (r < 2) ? WHITE : BLACK;
+            int row = (c == WHITE) ? 7 : 0, king = -1, rook = -1, step = (r % 2 == 0) ? -1 : 1;
+            for (int j = 0; j < 8; ++j)
+                if (board[row][j].type == 'K' && board[row][j].color == c) king = j;
+            for (int j = (r % 2 == 0) ? 7 : 0; king >= 0 && j != king && rook < 0; j += step)
+                if (board[row][j].type == 'R' && board[row][j].color == c) rook = j;
+            if (rook < 0) continue;
+            board[row][king].hasMoved = false;
+            board[row][rook].hasMoved = false;
+        }
+        chess960 = (in.flags & 32) != 0;
+
+        enPassantTarget = {-1, -1};
+        if (in.enPassant < 64) enPassantTarget = {in.enPassant / 8, in.enPassant % 8};
+        turn = (in.flags & 1) ? BLACK : WHITE;
+        invalidate();
+        return true;
+    }
+
+    static const int RENDER_SIZE = 512;  // Enough for one display() frame
+
+    int render(char *out)
+    {
+        // Lay the whole display out in one buffer so it can be written in a single call
+        static const char header[] = "   A  B  C  D  E  F  G  H\n";
+        char *p = out;
+        memcpy(p, "\n\n\n\n", 4);
+        p += 4;
+        memcpy(p, header, sizeof(header) - 1);
+        p += sizeof(header) - 1;
+        for (int i = 0; i < 8; ++i)
+        {
+            *p++ = char('0' + 8 - i);
+            *p++ = ' ';
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &sq = board[i][j];
+                p[0] = (sq.color == WHITE) ? '[' : (sq.color == BLACK) ? '(' : ' ';
+                p[1] = (sq.color == NONE) ? '.' : sq.type;
+                p[2] = (sq.color == WHITE) ? ']' : (sq.color == BLACK) ? ')' : ' ';
+                p += 3;
+            }
+            *p++ = ' ';
+            *p++ = char('0' + 8 - i);
+            *p++ = '\n';
+        }
+        memcpy(p, header, sizeof(header) - 1);
+        p += sizeof(header) - 1;
+        return int(p - out);
+    }
+
+    void squareCodes(char *out)
+    {
+        // One byte per square, row by row: FEN letters, '.' for empty
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j)
+            {
+                const Piece &p = board[i][j];
+                out[i * 8 + j] = (p.color == NONE) ? '.' : (p.color == WHITE) ? p.type : char(tolower(p.type));
+            }
+    }
+
+    void display()
+    {
+        char buffer[RENDER_SIZE];
+        std::cout.write(buffer, render(buffer));
+    }
+
+    bool isInsideBoard(int x, int y) const
+    {
+        return x >= 0 && x < 8 && y >= 0 && y < 8;
+    }
+
+    Piece &pieceAt(int x, int y)
+    {
+        // Callers may write through the reference, so the cached state can't be trusted
+        invalidate();
+        return board[x][y];
+    }
+
+    const Piece &pieceAt(int x, int y) const
+    {
+        // Reads leave the cached state alone
+        return board[x][y];
+    }
+
+    void invalidate()
+    {
+        state.turn = NONE;
+        attacks.turn = NONE;
+    }
+
+    unsigned long long hash(Color turn)
+    {
+        // Zobrist key of everything that decides the legal moves: pieces, castling flags,
+        // the en passant square and the side to move
+        const ZobristKeys &keys = zobristKeys();
+        unsigned long long key = (turn == BLACK) ? keys.blackToMove : 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                const Piece &p = board[i][j];
+                if (p.color == NONE) continue;
+                key ^= keys.pieces[pieceIndex(p)][i * 8 + j];
+                if ((p.type == 'K' || p.type == 'R') && !p.hasMoved) key ^= keys.unmoved[i * 8 + j];
+            }
+        }
+        if (isInsideBoard(enPassantTarget.first, enPassantTarget.second))
+            key ^= keys.enPassant[enPassantTarget.first * 8 + enPassantTarget.second];
+        return key;
+    }
+
+    unsigned long long attackedSquares(Color turn)
+    {
+        // Computed once per position and side; copies of the board share it until a move is made
+        if (attacks.turn == turn) return attacks.squares;
+
+        static const int knightSteps[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+        static const int kingSteps[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+        Color enemy = (turn == WHITE ? BLACK : WHITE);
+        unsigned long long map = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color != enemy) continue;
+
+                if (p.type == 'P')
+                {
+                    int x = i + (enemy == WHITE ? -1 : 1);
+                    for (int y = j - 1; y <= j + 1; y += 2)
+                        if (isInsideBoard(x, y)) map |= 1ULL << (x * 8 + y);
+                }
+                else if (p.type == 'N' || p.type == 'K')
+                {
+                    const int (*steps)[2] = (p.type == 'N') ? knightSteps : kingSteps;
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        int x = i + steps[k][0], y = j + steps[k][1];
+                        if (isInsideBoard(x, y)) map |= 1ULL << (x * 8 + y);
+                    }
+                }
+                else
+                {
+                    // Rays stop at the first piece, which is attacked (or defended) too
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        int stepX = kingSteps[k][0], stepY = kingSteps[k][1];
+                        bool diagonal = stepX != 0 && stepY != 0;
+                        if (p.type == 'R' && diagonal) continue;
+                        if (p.type == 'B' && !diagonal) continue;
+
+                        for (int x = i + stepX, y = j + stepY; isInsideBoard(x, y); x += stepX, y += stepY)
+                        {
+                            map |= 1ULL << (x * 8 + y);
+                            const Piece &q = board[x][y];
+                            if (q.type != ' ' && !(q.type == 'K' && q.color == turn)) break;
+                        }
+                    }
+                }
+            }
+        }
+
+        attacks.turn = turn;
+        attacks.squares = map;
+        return map;
+    }
+
+    bool canPieceAttack(int sx, int sy, int ex, int ey, Piece &p)
+    {
+        PROFILE_SCOPE(PROFILE_CAN_PIECE_ATTACK);
+        // Check if piece can attack the target position (ex, ey)
+
+        // PAWN
+        if (p.type == 'P')
+        {
+            int dir = (p.color == WHITE) ? -1 : 1;
+            if (ex - sx == dir && abs(sy - ey) == 1)
+            {
+                if (board[ex][ey].color != p.color && board[ex][ey].type != ' ')
+                {
+                    return true; // Pawn can capture diagonally
+                }
+            }
+        }
+
+        // KNIGHT
+        else if (p.type == 'N')
+        {
+            if ((abs(sx - ex) == 2 && abs(sy - ey) == 1) || (abs(sx - ex) == 1 && abs(sy - ey) == 2))
+            {
+                return true; // Knight's L-shaped move
+            }
+        }
+
+        // KING
+        else if (p.type == 'K')
+        {
+            if (abs(sx - ex) <= 1 && abs(sy - ey) <= 1)
+            {
+                return true; // King moves one square in any direction
+            }
+        }
+
+        // ROOK
+        else if (p.type == 'R')
+        {
+            if (sx != ex && sy != ey) return false;  // Rooks move only in straight lines
+
+            int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
+            int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
+
+            for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+            {
+                if (board[x][y].type != ' ') return false;  // Blocked by another piece
+            }
+            return true;
+        }
+
+        // BISHOP
+        else if (p.type == 'B')
+        {
+            if (abs(sx - ex) != abs(sy - ey)) return false;  // Bishops move diagonally
+
+            int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
+            int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
+
+            for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+            {
+                if (board[x][y].type != ' ') return false;  // Blocked by another piece
+            }
+            return true;
+        }
+
+        // QUEEN
+        else if (p.type == 'Q')
+        {
+            if (sx == ex || sy == ey)
+            {
+                // Horizontal or vertical movement like rook
+                int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
+                int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
+
+                for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+                {
+                    if (board[x][y].type != ' ') return false;  // Blocked by another piece
+                }
+                return true;
+            } else if (abs(sx - ex) == abs(sy - ey))
+            {
+                // Diagonal movement like bishop
+                int stepX = (ex > sx) ? 1 : (ex < sx) ? -1 : 0;
+                int stepY = (ey > sy) ? 1 : (ey < sy) ? -1 : 0;
+
+                for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+                {
+                    if (board[x][y].type != ' ') return false;  // Blocked by another piece
+                }
+                return true;
+            }
+        }
+
+        return false; // Default return value
+    }
+
+    bool isCheck(Color turn)
+    {
+        PROFILE_SCOPE(PROFILE_IS_CHECK);
+        // Find the current player's king
+        std::pair<int, int> kingPos = {-1, -1};
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                if (board[i][j].type == 'K' && board[i][j].color == turn)
+                {
+                    kingPos = {i, j};
+                    break;
+                }
+            }
+        }
+        if (kingPos.first < 0) return false;  // No king to attack
+
+        // Check if any opposing piece can attack the king
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color == (turn == WHITE ? BLACK : WHITE))
+                {
+                    // Try every possible move of the piece and check if it can reach the king
+                    if (canPieceAttack(i, j, kingPos.first, kingPos.second, p))
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool movePiece(int sx, int sy, int ex, int ey, Color turn, char promotion = ' ')
+    {
+        // promotion is one of Q, R, B, N, or ' ' for a queen; the move is refused if it leaves the king in check
+        UndoRecord undo;
+        return makeMove(Move(sx, sy, ex, ey, promotion), turn, undo);
+    }
+
+    bool applyMove(int sx, int sy, int ex, int ey, Color turn, char promotion)
+    {
+        // Plays a pseudo-legal move on squares already known to be on the board; makeMove checks the king afterwards
+        Piece &p = board[sx][sy];
+        if (p.color != turn) return false;
+
+        Piece &target = board[ex][ey];
+        int dx = ex - sx, dy = ey - sy;
+        if (chess960 && p.type == 'K' && target.type == 'R' && target.color == turn) return castle960(sx, sy, ex, ey, turn);
+        if (target.color == turn)
+        {
+            return false;
+        }
+
+        // PAWN
+        if (p.type == 'P')
+        {
+            int dir = (p.color == WHITE) ? -1 : 1;
+            char promote = (promotion == ' ') ? 'Q' : char(toupper(promotion));
+            // strchr would match a NUL promotion against the terminator
+            if ((ex == 0 || ex == 7) && (promote == '\0' || !strchr("QRBN", promote))) return false;
+
+            // Single forward move
+            if (dy == 0 && dx == dir && target.type == ' ')
+            {
+                board[ex][ey] = p;
+                board[sx][sy] = Piece();
+            }
+            // Double forward move
+            else if (dy == 0 && dx == 2 * dir && sx == (p.color == WHITE ? 6 : 1) &&
+                     board[sx + dir][sy].type == ' ' && target.type == ' ')
+            {
+                board[ex][ey] = p;
+                board[sx][sy] = Piece();
+                enPassantTarget = {sx + dir, sy};  // Set en passant target square
+            }
+            // Standard diagonal capture
+            else if (abs(dy) == 1 && dx == dir && target.color == (p.color == WHITE ? BLACK : WHITE))
+            {
+                board[ex][ey] = p;
+                board[sx][sy] = Piece();
+            }
+            // En passant capture
+            else if (abs(dy) == 1 && dx == dir && ex == enPassantTarget.first && ey == enPassantTarget.second)
+            {
+                board[ex][ey] = p;
+                board[sx][sy] = Piece();
+                board[sx][ey] = Piece();  // Capture the pawn behind
+            }
+            else
+            {
+                return false;  // Invalid pawn move
+            }
+
+            // Reset en passant if not double move
+            if (!(dy == 0 && dx == 2 * dir))
+            {
+                enPassantTarget = {-1, -1};
+            }
+
+            // Promotion
+            if (ex == 0 || ex == 7) board[ex][ey].type = promote;
+
+            board[ex][ey].hasMoved = true;
+            invalidate();
+            return true;
+        }
+
+        // KNIGHT
+        else if (p.type == 'N')
+        {
+            if (!(abs(dx) == 2 && abs(dy) == 1) && !(abs(dx) == 1 && abs(dy) == 2)) return false;
+        }
+
+        // KING
+        else if (p.type == 'K')
+        {
+            unsigned long long attacked = attackedSquares(turn);
+            if (abs(dy) == 2 && dx == 0 && !p.hasMoved && !chess960)
+            {
+                // Castling: the path must be empty, and the king may not start on, cross or land on an attacked square
+                int rookY = (dy == 2) ? 7 : 0;
+                int dir = (dy > 0) ? 1 : -1;
+                for (int i = sy + dir; i != rookY; i += dir) if (board[sx][i].type != ' ') return false;
+                for (int i = sy; i != ey + dir; i += dir) if (attacked >> (sx * 8 + i) & 1) return false;
+                if (board[sx][rookY].type == 'R' && !board[sx][rookY].hasMoved)
+                {
+                    board[sx][sy + dir] = board[sx][rookY];
+                    board[sx][rookY] = Piece();
+                } else return false;
+            } else if (abs(dx) > 1 || abs(dy) > 1) return false;
+            else if (attacked >> (ex * 8 + ey) & 1) return false;  // Stepping into check
+        }
+
+        // ROOK
+        else if (p.type == 'R')
+        {
+            if (dx != 0 && dy != 0) return false;
+            int stepX = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
+            int stepY = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
+            for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+            {
+                if (board[x][y].type != ' ') return false;
+            }
+        }
+
+        // BISHOP
+        else if (p.type == 'B')
+        {
+            if (abs(dx) != abs(dy)) return false;
+            int stepX = (dx > 0) ? 1 : -1;
+            int stepY = (dy > 0) ? 1 : -1;
+            for (int x = sx + stepX, y = sy + stepY; x != ex; x += stepX, y += stepY)
+            {
+                if (board[x][y].type != ' ') return false;
+            }
+        }
+
+        // QUEEN
+        else if (p.type == 'Q')
+        {
+            if (dx == 0 || dy == 0)
+            {
+                int stepX = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
+                int stepY = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
+                for (int x = sx + stepX, y = sy + stepY; x != ex || y != ey; x += stepX, y += stepY)
+                {
+                    if (board[x][y].type != ' ') return false;
+                }
+            } else if (abs(dx) == abs(dy))
+            {
+                int stepX = (dx > 0) ? 1 : -1;
+                int stepY = (dy > 0) ? 1 : -1;
+                for (int x = sx + stepX, y = sy + stepY; x != ex; x += stepX, y += stepY)
+                {
+                    if (board[x][y].type != ' ') return false;
+                }
+            } else return false;
+        }
+
+        // Execute move
+        board[ex][ey] = p;
+        board[ex][ey].hasMoved = true;
+        board[sx][sy] = Piece();
+        enPassantTarget = {-1, -1};
+        invalidate();
+        return true;
+    }
+
+    bool castle960(int sx, int sy, int ex, int ey, Color turn)
+    {
+        // King at (sx, sy) castles with its own rook at (ex, ey), ending on the g or c file
+        // with the rook beside it. Only the king and that rook may stand between the four squares.
+        if (sx != ex || sx != (turn == WHITE ? 7 : 0) || board[sx][sy].hasMoved || board[ex][ey].hasMoved) return false;
+        bool kingSide = ey > sy;
+        int kingTo = kingSide ? 6 : 2, rookTo = kingSide ? 5 : 3;
+        int from = std::min(std::min(sy, ey), std::min(kingTo, rookTo));
+        int to = std::max(std::max(sy, ey), std::max(kingTo, rookTo));
+        for (int j = from; j <= to; ++j)
+            if (j != sy && j != ey && board[sx][j].type != ' ') return false;
+
+        // Every square the king stands on or crosses must be safe; makeMove still tests the
+        // final position, where the rook that moved away may have been blocking a line
+        unsigned long long attacked = attackedSquares(turn);
+        for (int j = std::min(sy, kingTo); j <= std::max(sy, kingTo); ++j)
+            if (attacked >> (sx * 8 + j) & 1) return false;
+
+        Piece king = board[sx][sy], rook = board[ex][ey];
+        board[sx][sy] = Piece();
+        board[ex][ey] = Piece();
+        board[sx][kingTo] = king;
+        board[sx][rookTo] = rook;
+        board[sx][kingTo].hasMoved = true;
+        board[sx][rookTo].hasMoved = true;
+        enPassantTarget = {-1, -1};
+        invalidate();
+        return true;
+    }
+
+    const PositionState &positionState(Color turn)
+    {
+        // Computed once per position and side, then answered from the cache until a move is made
+        if (state.turn == turn) return state;
+
+        PositionState fresh;
+        fresh.turn = turn;
+        Color enemy = (turn == WHITE ? BLACK : WHITE);
+        std::pair<int, int> king = findKing(turn);
+
+        if (king.first >= 0)
+        {
+            for (std::pair<int, int> &a : getAttackers(king.first, king.second, enemy))
+                fresh.checkers |= 1ULL << (a.first * 8 + a.second);
+            fresh.pinned = pinnedPieces(turn, king);
+        }
+
+        fresh.legalMoves = countLegalMoves(turn);
+        if (fresh.legalMoves == 0) fresh.result = fresh.checkers ? CHECKMATE : STALEMATE;
+
+        state = fresh;
+        return state;
+    }
+
+    unsigned long long pinnedPieces(Color turn, std::pair<int, int> king) const
+    {
+        // Walk out from the king: one own piece followed by an enemy slider on that line is pinned
+        static const int steps[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+        unsigned long long pinned = 0;
+        for (int k = 0; k < 8; ++k)
+        {
+            bool diagonal = steps[k][0] != 0 && steps[k][1] != 0;
+            int ownX = -1, ownY = -1;
+            for (int x = king.first + steps[k][0], y = king.second + steps[k][1]; isInsideBoard(x, y);
+                 x += steps[k][0], y += steps[k][1])
+            {
+                const Piece &p = board[x][y];
+                if (p.type == ' ') continue;
+                if (p.color == turn)
+                {
+                    if (ownX >= 0) break;  // Two own pieces: nothing pinned
+                    ownX = x;
+                    ownY = y;
+                    continue;
+                }
+                bool slider = p.type == 'Q' || p.type == (diagonal ? 'B' : 'R');
+                if (slider && ownX >= 0) pinned |= 1ULL << (ownX * 8 + ownY);
+                break;
+            }
+        }
+        return pinned;
+    }
+
+    bool isCheckmate(Color turn)
+    {
+        PROFILE_SCOPE(PROFILE_IS_CHECKMATE);
+        return positionState(turn).result == CHECKMATE;
+    }
+
+    bool isStalemate(Color turn)
+    {
+        PROFILE_SCOPE(PROFILE_IS_STALEMATE);
+        return positionState(turn).result == STALEMATE;
+    }
+
+    std::pair<int, int> findKing(Color turn)
+    {
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j)
+                if (board[i][j].type == 'K' && board[i][j].color == turn) return {i, j};
+        return {-1, -1};
+    }
+
+    std::vector<std::pair<int, int>> getAttackers(int ex, int ey, Color color)
+    {
+        // List every piece of the given color that attacks (ex, ey), cheapest first
+        std::vector<std::pair<int, int>> attackers;
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color == color && (i != ex || j != ey) && canPieceAttack(i, j, ex, ey, p))
+                {
+                    attackers.push_back({i, j});
+                }
+            }
+        }
+
+        std::stable_sort(attackers.begin(), attackers.end(),
+                         [this](const std::pair<int, int> &a, const std::pair<int, int> &b)
+                         {
+                             return pieceValue(board[a.first][a.second].type) < pieceValue(board[b.first][b.second].type);
+                         });
+        return attackers;
+    }
+
+    std::vector<Move> generateCaptures(Color turn)
+    {
+        // Captures and queen promotions only, ordered by MVV-LVA.
+        // Moves are pseudo-legal: movePiece still rejects the ones that leave the king in check.
+        std::vector<Move> moves;
+        Color enemy = (turn == WHITE ? BLACK : WHITE);
+        int lastRank = (turn == WHITE ? 0 : 7);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color != turn) continue;
+
+                for (int x = 0; x < 8; ++x)
+                {
+                    for (int y = 0; y < 8; ++y)
+                    {
+                        if (board[x][y].color != enemy) continue;
+                        if (!canPieceAttack(i, j, x, y, p)) continue;
+
+                        Move m(i, j, x, y, (p.type == 'P' && x == lastRank) ? 'Q' : ' ');
+                        m.score = 10 * pieceValue(board[x][y].type) - pieceValue(p.type);
+                        if (m.promotion != ' ') m.score += pieceValue('Q');
+                        moves.push_back(m);
+                    }
+                }
+
+                if (p.type == 'P')
+                {
+                    int dir = (turn == WHITE) ? -1 : 1;
+
+                    // Quiet promotion
+                    if (i + dir == lastRank && board[i + dir][j].type == ' ')
+                    {
+                        Move m(i, j, i + dir, j, 'Q');
+                        m.score = pieceValue('Q') - pieceValue('P');
+                        moves.push_back(m);
+                    }
+
+                    // En passant
+                    if (i + dir == enPassantTarget.first && abs(j - enPassantTarget.second) == 1)
+                    {
+                        Move m(i, j, enPassantTarget.first, enPassantTarget.second);
+                        m.score = 10 * pieceValue('P') - pieceValue('P');
+                        moves.push_back(m);
+                    }
+                }
+            }
+        }
+
+        std::stable_sort(moves.begin(), moves.end(), [](const Move &a, const Move &b) { return a.score > b.score; });
+        return moves;
+    }
+
+    std::vector<Move> generateMoves(Color turn)
+    {
+        // Every pseudo-legal move for one side, unordered.
+        // movePiece is still the referee and rejects moves that leave the king in check.
+        std::vector<Move> moves;
+        static const int knightSteps[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+        static const int kingSteps[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+        static const char promotions[4] = {'Q', 'R', 'B', 'N'};
+
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color != turn) continue;
+
+                if (p.type == 'P')
+                {
+                    int dir = (turn == WHITE) ? -1 : 1;
+                    int lastRank = (turn == WHITE) ? 0 : 7;
+                    std::vector<std::pair<int, int>> targets;
+
+                    if (isInsideBoard(i + dir, j) && board[i + dir][j].type == ' ')
+                    {
+                        targets.push_back({i + dir, j});
+                        if (i == (turn == WHITE ? 6 : 1) && board[i + 2 * dir][j].type == ' ')
+                            targets.push_back({i + 2 * dir, j});
+                    }
+                    for (int dy = -1; dy <= 1; dy += 2)
+                    {
+                        int x = i + dir, y = j + dy;
+                        if (!isInsideBoard(x, y)) continue;
+                        if ((board[x][y].color != NONE && board[x][y].color != turn) ||
+                            (x == enPassantTarget.first && y == enPassantTarget.second))
+                            targets.push_back({x, y});
+                    }
+
+                    for (auto &t : targets)
+                    {
+                        if (t.first == lastRank)
+                        {
+                            for (char promo : promotions) moves.push_back(Move(i, j, t.first, t.second, promo));
+                        } else
+                        {
+                            moves.push_back(Move(i, j, t.first, t.second));
+                        }
+                    }
+                }
+                else if (p.type == 'N' || p.type == 'K')
+                {
+                    const int (*steps)[2] = (p.type == 'N') ? knightSteps : kingSteps;
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        int x = i + steps[k][0], y = j + steps[k][1];
+                        if (isInsideBoard(x, y) && board[x][y].color != turn) moves.push_back(Move(i, j, x, y));
+                    }
+
+                    // Castling, both sides; movePiece checks the path and the rook
+                    if (p.type == 'K' && !p.hasMoved && chess960)
+                    {
+                        for (int y = 0; y < 8; ++y)
+                            if (board[i][y].type == 'R' && board[i][y].color == turn && !board[i][y].hasMoved)
+                                moves.push_back(Move(i, j, i, y));
+                    }
+                    else if (p.type == 'K' && !p.hasMoved)
+                    {
+                        moves.push_back(Move(i, j, i, j + 2));
+                        moves.push_back(Move(i, j, i, j - 2));
+                    }
+                }
+                else
+                {
+                    // Sliding pieces walk each ray until blocked
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        int stepX = kingSteps[k][0], stepY = kingSteps[k][1];
+                        bool diagonal = stepX != 0 && stepY != 0;
+                        if (p.type == 'R' && diagonal) continue;
+                        if (p.type == 'B' && !diagonal) continue;
+
+                        for (int x = i + stepX, y = j + stepY; isInsideBoard(x, y); x += stepX, y += stepY)
+                        {
+                            if (board[x][y].color == turn) break;
+                            moves.push_back(Move(i, j, x, y));
+                            if (board[x][y].type != ' ') break;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Drop castling moves that would leave the board
+        moves.erase(std::remove_if(moves.begin(), moves.end(),
+                                   [this](const Move &m) { return !isInsideBoard(m.ex, m.ey); }),
+                    moves.end());
+        return moves;
+    }
+
+    bool isCapture(const Move &m) const
+    {
+        // A Chess960 castle lands on the mover's own rook, which is no capture
+        if (board[m.ex][m.ey].type != ' ') return board[m.ex][m.ey].color != board[m.sx][m.sy].color;
+        return board[m.sx][m.sy].type == 'P' && m.sy != m.ey;  // En passant
+    }
+
+    bool hasNonPawnMaterial(Color turn)
+    {
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j)
+                if (board[i][j].color == turn && board[i][j].type != 'P' && board[i][j].type != 'K') return true;
+        return false;
+    }
+
+    std::vector<Move> collectLegalMoves(Color turn, int fromX = -1, int fromY = -1)
+    {
+        // Tried in place: the attack map built for the first king move survives each undo.
+        // Out of check, a move by an unpinned piece other than the king can't expose the king,
+        // so it skips the check test; en passant empties two squares on a line and never does.
+        std::pair<int, int> king = findKing(turn);
+        bool inCheck = king.first < 0 || (attackedSquares(turn) >> (king.first * 8 + king.second) & 1);
+        unsigned long long pinned = inCheck ? 0 : pinnedPieces(turn, king);
+
+        std::vector<Move> legal;
+        for (Move &m : generateMoves(turn))
+        {
+            if (fromX >= 0 && (m.sx != fromX || m.sy != fromY)) continue;
+            const Piece &p = board[m.sx][m.sy];
+            bool enPassant = p.type == 'P' && m.sy != m.ey && board[m.ex][m.ey].type == ' ';
+            bool kingSafe = !inCheck && p.type != 'K' && !enPassant && !(pinned >> (m.sx * 8 + m.sy) & 1);
+            UndoRecord undo;
+            if (!makeMove(m, turn, undo, kingSafe)) continue;
+            unmakeMove(undo);
+            legal.push_back(m);
+        }
+        return legal;
+    }
+
+    int countLegalMoves(Color turn)
+    {
+        return (int)collectLegalMoves(turn).size();
+    }
+
+    bool makeMove(const Move &m, Color turn, UndoRecord &undo, bool kingSafe = false)
+    {
+        // Plays m, remembering the squares it may touch first; an illegal move leaves the board as it was.
+        // kingSafe skips the final check test for a move the caller knows can't expose the king.
+        undo = UndoRecord();
+        undo.move = m;
+        undo.enPassantTarget = enPassantTarget;
+        auto save = [&](int x, int y)
+        {
+            if (!isInsideBoard(x, y)) return;
+            for (int k = 0; k < undo.count; ++k)
+                if (undo.squares[k] == x * 8 + y) return;
+            undo.squares[undo.count] = (signed char)(x * 8 + y);
+            undo.pieces[undo.count++] = board[x][y];
+        };
+        if (!isInsideBoard(m.sx, m.sy) || !isInsideBoard(m.ex, m.ey)) return false;
+        PROFILE_SCOPE(PROFILE_MOVE_PIECE);
+
+        const Piece &p = board[m.sx][m.sy];
+        const Piece &target = board[m.ex][m.ey];
+        save(m.sx, m.sy);
+        save(m.ex, m.ey);
+        if (p.type == 'P' && m.sy != m.ey && target.type == ' ') save(m.sx, m.ey);
+        if (p.type == 'K' && chess960 && target.type == 'R' && target.color == p.color)
+        {
+            save(m.sx, m.ey > m.sy ? 6 : 2);
+            save(m.sx, m.ey > m.sy ? 5 : 3);
+        }
+        else if (p.type == 'K' && abs(m.ey - m.sy) == 2)
+        {
+            save(m.sx, m.ey > m.sy ? 7 : 0);
+            save(m.sx, (m.sy + m.ey) / 2);
+        }
+
+        // King moves need the attack map; building it first lets unmakeMove restore it for the next try
+        if (p.type == 'K') attackedSquares(turn);
+        undo.attacks = attacks;
+
+        if (!applyMove(m.sx, m.sy, m.ex, m.ey, turn, m.promotion)) return false;
+        // A king step was already checked against the attack map; everything else is tested on the result
+        bool kingStep = undo.pieces[0].type == 'K' && abs(m.ey - m.sy) <= 1 && undo.pieces[1].color != turn;
+        if (!kingStep && !kingSafe && isCheck(turn))
+        {
+            unmakeMove(undo);
+            return false;
+        }
+        // The piece actually promoted to, so a ' ' request reads as the queen; ' ' for any other move
+        bool promoting = undo.pieces[0].type == 'P' && (m.ex == 0 || m.ex == 7);
+        undo.move.promotion = promoting ? board[m.ex][m.ey].type : ' ';
+        return true;
+    }
+
+    void unmakeMove(const UndoRecord &undo)
+    {
+        for (int k = 0; k < undo.count; ++k) board[undo.squares[k] / 8][undo.squares[k] % 8] = undo.pieces[k];
+        enPassantTarget = undo.enPassantTarget;
+        invalidate();
+        attacks = undo.attacks;
+    }
+
+    std::pair<int, int> makeNullMove()
+    {
+        // Pass the turn without moving: only the en passant right lapses.
+        // The side to move is the caller's turn variable, so nothing else changes.
+        std::pair<int, int> saved = enPassantTarget;
+        enPassantTarget = {-1, -1};
+        invalidate();
+        return saved;
+    }
+
+    void unmakeNullMove(std::pair<int, int> saved)
+    {
+        enPassantTarget = saved;
+        invalidate();
+    }
+
+    int staticExchange(const Move &m, Color turn)
+    {
+        // Net material the side to move wins on the target square if both sides
+        // keep recapturing with their cheapest attacker
+        Piece &p = board[m.sx][m.sy];
+        bool enPassant = p.type == 'P' && board[m.ex][m.ey].type == ' ' && m.sy != m.ey;
+        int gain = enPassant ? pieceValue('P') : pieceValue(board[m.ex][m.ey].type);
+
+        BoardArena arena;
+        Board temp = *this;
+        temp.board[m.ex][m.ey] = p;
+        temp.board[m.sx][m.sy] = Piece();
+        if (enPassant) temp.board[m.sx][m.ey] = Piece();
+        if (m.promotion != ' ')
+        {
+            temp.board[m.ex][m.ey].type = m.promotion;
+            gain += pieceValue(m.promotion) - pieceValue('P');
+        }
+
+        return gain - temp.exchangeOn(m.ex, m.ey, (turn == WHITE ? BLACK : WHITE));
+    }
+
+    int exchangeOn(int ex, int ey, Color side)
+    {
+        // Best result for side when it may recapture on (ex, ey) or stop.
+        // Pieces are lifted off the board, so x-ray attackers join in naturally.
+        std::vector<std::pair<int, int>> attackers = getAttackers(ex, ey, side);
+        if (attackers.empty()) return 0;
+
+        int ax = attackers[0].first, ay = attackers[0].second;
+        int captured = pieceValue(board[ex][ey].type);
+        BoardArena arena;
+        Board temp = *this;
+        temp.board[ex][ey] = board[ax][ay];
+        temp.board[ax][ay] = Piece();
+
+        return std::max(0, captured - temp.exchangeOn(ex, ey, (side == WHITE ? BLACK : WHITE)));
+    }
+
+    int evaluate(Color turn)
+    {
+        // Material plus small bonuses for centralized minor pieces and advanced pawns,
+        // scored from the side to move's point of view
+        int score = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = board[i][j];
+                if (p.color == NONE) continue;
+
+                int value = pieceValue(p.type);
+                if (p.type == 'N' || p.type == 'B')
+                {
+                    value += 10 - 3 * (abs(2 * i - 7) + abs(2 * j - 7)) / 2;
+                } else if (p.type == 'P')
+                {
+                    value += 5 * (p.color == WHITE ? 6 - i : i - 1);
+                }
+                score += (p.color == turn) ? value : -value;
+            }
+        }
+        return score;
+    }
+};
+
+inline std::vector<Move> legalMoves(Board &board, Color turn, int fromX = -1, int fromY = -1)
+{
+    // All legal moves, or only those from (fromX, fromY) when a square is given
+    return board.collectLegalMoves(turn, fromX, fromY);
+}
+
+#endif
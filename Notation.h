@@ -0,0 +1,95 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// Standard algebraic notation (Nf3, exd5, O-O, e8=Q+) and coordinate notation (g1f3, e7e8q).
+
+inline std::string squareText(int x, int y)
+{
+    return std::string(1, char('a' + y)) + char('0' + 8 - x);
+}
+
+inline std::string toCoordinate(const Move &m)
+{
+    std::string text = squareText(m.sx, m.sy) + squareText(m.ex, m.ey);
+    if (m.promotion != ' ') text += char(tolower(m.promotion));
+    return text;
+}
+
+inline std::string toSan(Board &board, const Move &m, Color turn, bool checkMarks = true)
+{
+    // m must be legal for turn
+    char type = board.pieceAt(m.sx, m.sy).type;
+    std::string san;
+
+    const Piece &target = board.pieceAt(m.ex, m.ey);
+    bool castle960 = board.chess960 && target.type == 'R' && target.color == turn;
+    if (type == 'K' && ((abs(m.ey - m.sy) == 2 && !board.chess960) || castle960))
+    {
+        san = (m.ey > m.sy) ? "O-O" : "O-O-O";
+    }
+    else
+    {
+        bool capture = board.isCapture(m);
+        if (type == 'P')
+        {
+            if (capture) san += char('a' + m.sy);
+        }
+        else
+        {
+            san += type;
+            // Name the origin file, rank or both when another piece of this type could go there too
+            bool ambiguous = false, sameFile = false, sameRank = false;
+            for (Move &other : legalMoves(board, turn))
+            {
+                if (other.ex != m.ex || other.ey != m.ey || (other.sx == m.sx && other.sy == m.sy)) continue;
+                if (board.pieceAt(other.sx, other.sy).type != type) continue;
+                ambiguous = true;
+                sameFile |= other.sy == m.sy;
+                sameRank |= other.sx == m.sx;
+            }
+            if (ambiguous && (!sameFile || sameRank)) san += char('a' + m.sy);
+            if (ambiguous && sameFile) san += char('0' + 8 - m.sx);
+        }
+        if (capture) san += 'x';
+        san += squareText(m.ex, m.ey);
+        if (m.promotion != ' ') san += std::string("=") + m.promotion;
+    }
+
+    if (!checkMarks) return san;
+    BoardArena arena;
+    Board after = board;
+    after.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+    Color enemy = (turn == WHITE ? BLACK : WHITE);
+    if (after.isCheck(enemy)) san += legalMoves(after, enemy).empty() ? '#' : '+';
+    return san;
+}
+
+inline std::string stripAnnotations(const std::string &text)
+{
+    // Drops check marks, annotation glyphs and the '=' of a promotion so spellings compare equal
+    std::string out;
+    for (char c : text)
+        if (!strchr("+#!?=", c)) out += (c == '0') ? 'O' : c;
+    return out;
+}
+
+inline Move parseMove(Board &board, const std::string &text, Color turn)
+{
+    // Accepts SAN or coordinates; returns Move() (sx == -1) when no legal move matches
+    std::string wanted = stripAnnotations(text);
+    std::string lower = wanted;
+    for (char &c : lower) c = tolower(c);
+
+    for (Move &m : legalMoves(board, turn))
+    {
+        if (lower == toCoordinate(m)) return m;
+        if (wanted == stripAnnotations(toSan(board, m, turn, false))) return m;
+    }
+    return Move();
+}
+
+#endif
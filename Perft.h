@@ -0,0 +1,126 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Board.h"
+
+// Move path enumeration: counts the leaf nodes of the legal move tree to a fixed depth.
+// Subtree counts are cached by (zobrist key, depth) in a table shared by all threads.
+
+class PerftTable
+{
+    // Lockless entries: the check word is key ^ count, so a torn write from another
+    // thread fails verification and reads as a miss instead of a wrong count
+    struct Entry
+    {
+        std::atomic<unsigned long long> check{0};
+        std::atomic<unsigned long long> count{0};
+    };
+
+    std::vector<Entry> entries;
+    unsigned long long mask = 0;
+
+    static unsigned long long keyFor(unsigned long long hash, int depth)
+    {
+        return hash ^ (depth * 0x9E3779B97F4A7C15ULL);
+    }
+
+public:
+    explicit PerftTable(size_t megabytes)
+    {
+        size_t size = 1;
+        while (size * 2 * sizeof(Entry) <= megabytes * 1024 * 1024) size *= 2;
+        entries = std::vector<Entry>(megabytes ? size : 0);
+        mask = size - 1;
+    }
+
+    bool probe(unsigned long long hash, int depth, unsigned long long &count)
+    {
+        if (entries.empty()) return false;
+        unsigned long long key = keyFor(hash, depth);
+        Entry &e = entries[key & mask];
+        unsigned long long stored = e.count.load(std::memory_order_relaxed);
+        if ((e.check.load(std::memory_order_relaxed) ^ stored) != key || stored == 0) return false;
+        count = stored;
+        return true;
+    }
+
+    void store(unsigned long long hash, int depth, unsigned long long count)
+    {
+        if (entries.empty()) return;
+        unsigned long long key = keyFor(hash, depth);
+        Entry &e = entries[key & mask];
+        e.check.store(key ^ count, std::memory_order_relaxed);
+        e.count.store(count, std::memory_order_relaxed);
+    }
+};
+
+inline unsigned long long perft(Board &board, Color turn, int depth, PerftTable *table = nullptr)
+{
+    if (depth == 0) return 1;
+
+    unsigned long long hash = 0, nodes = 0;
+    if (table && depth > 1)
+    {
+        hash = board.hash(turn);
+        if (table->probe(hash, depth, nodes)) return nodes;
+    }
+
+    std::vector<Move> moves = legalMoves(board, turn);
+    if (depth == 1) return moves.size();  // Bulk count at the frontier
+
+    Color opponent = (turn == WHITE ? BLACK : WHITE);
+    for (Move &m : moves)
+    {
+        BoardArena arena;
+        Board child = board;
+        child.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+        nodes += perft(child, opponent, depth - 1, table);
+    }
+
+    if (table) table->store(hash, depth, nodes);
+    return nodes;
+}
+
+struct PerftDivide
+{
+    Move move;
+    unsigned long long nodes = 0;
+};
+
+inline std::vector<PerftDivide> perftDivide(Board &board, Color turn, int depth, int threads, PerftTable *table = nullptr)
+{
+    // Root moves are handed out one at a time, so a thread that drew a small subtree picks up the next
+    std::vector<PerftDivide> results;
+    for (Move &m : legalMoves(board, turn))
+    {
+        PerftDivide d;
+        d.move = m;
+        results.push_back(d);
+    }
+    if (depth < 1) return results;
+
+    std::atomic<size_t> next(0);
+    Color opponent = (turn == WHITE ? BLACK : WHITE);
+    auto worker = [&]() {
+        for (size_t i = next++; i < results.size(); i = next++)
+        {
+            BoardArena arena;
+            Board child = board;
+            Move &m = results[i].move;
+            child.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+            results[i].nodes = perft(child, opponent, depth - 1, table);
+        }
+    };
+
+    threads = std::max(1, std::min(threads, (int)results.size()));
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread &t : pool) t.join();
+    return results;
+}
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include "Board.h"
+#include "Notation.h"
+
+// Game records in PGN: the tag pairs, then the moves in SAN from the start position.
+
+struct GameRecord
+{
+    std::string startFen;  // Empty for the standard start
+    bool chess960 = false;
+    std::vector<Move> moves;
+    std::string result = "*";  // 1-0, 0-1, 1/2-1/2 or * while in progress
+};
+
+inline bool setupFromRecord(const GameRecord &record, Board &board, Color &turn)
+{
+    board = Board();
+    turn = WHITE;
+    // A Chess960 start can look like a standard FEN, so the tag can switch the rules on;
+    // castling rights that only make sense in Chess960 switch them on without a tag
+    bool loaded = record.startFen.empty() || board.loadFen(record.startFen, turn);
+    board.chess960 = board.chess960 || record.chess960;
+    return loaded;
+}
+
+inline std::string writePgn(const GameRecord &record)
+{
+    Board board;
+    Color turn;
+    if (!setupFromRecord(record, board, turn)) return "";
+
+    std::ostringstream out;
+    out << "[Event \"Casual game\"]\n[White \"White\"]\n[Black \"Black\"]\n[Result \"" << record.result << "\"]\n";
+    if (record.chess960) out << "[Variant \"Chess960\"]\n";
+    if (!record.startFen.empty()) out << "[SetUp \"1\"]\n[FEN \"" << record.startFen << "\"]\n";
+    out << "\n";
+
+    // Move numbers count from 1 even after a FEN start; a line break every eight moves
+    int number = 1, column = 0;
+    for (size_t i = 0; i < record.moves.size(); ++i)
+    {
+        const Move &m = record.moves[i];
+        if (turn == WHITE || i == 0) out << number << (turn == WHITE ? ". " : "... ");
+        out << toSan(board, m, turn) << (++column % 16 == 0 ? "\n" : " ");
+        board.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+        if (turn == BLACK) ++number;
+        turn = (turn == WHITE ? BLACK : WHITE);
+    }
+    out << record.result << "\n";
+    return out.str();
+}
+
+inline bool readPgn(const std::string &text, GameRecord &record)
+{
+    // One game: tags, then movetext. Comments, variations, NAGs and move numbers are skipped.
+    record = GameRecord();
+    std::istringstream in(text);
+    std::string line, movetext;
+    while (std::getline(in, line))
+    {
+        if (!line.empty() && line[0] == '[')
+        {
+            size_t open = line.find('"'), close = line.rfind('"');
+            if (open == std::string::npos || close <= open) continue;
+            std::string name = line.substr(1, line.find(' ') - 1), value = line.substr(open + 1, close - open - 1);
+            if (name == "FEN") record.startFen = value;
+            else if (name == "Variant")
+                record.chess960 = value.find("960") != std::string::npos || value.find("ischerandom") != std::string::npos;
+        }
+        else movetext += line + " ";
+    }
+
+    Board board;
+    Color turn;
+    if (!setupFromRecord(record, board, turn)) return false;
+    record.chess960 = board.chess960;
+
+    int depth = 0;  // Inside comments or variations
+    std::string token;
+    for (size_t i = 0; i <= movetext.size(); ++i)
+    {
+        char c = (i < movetext.size()) ? movetext[i] : ' ';
+        if (c == '{' || c == '(') ++depth;
+        else if ((c == '}' || c == ')') && depth > 0) --depth;
+        if (depth > 0 || c == '}' || c == ')') continue;
+        if (!isspace(c))
+        {
+            token += c;
+            continue;
+        }
+        if (token.empty()) continue;
+
+        // Strip a "12." or "12..." prefix; moves themselves never contain a dot
+        size_t dot = token.rfind('.');
+        std::string word = (dot == std::string::npos) ? token : token.substr(dot + 1);
+        token.clear();
+
+        if (word == "1-0" || word == "0-1" || word == "1/2-1/2" || word == "*")
+        {
+            record.result = word;
+            break;
+        }
+        if (word.empty() || word[0] == '$') continue;
+
+        Move m = parseMove(board, word, turn);
+        if (m.sx < 0) return false;
+        record.moves.push_back(m);
+        board.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+        turn = (turn == WHITE ? BLACK : WHITE);
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef POSITION_FILE_H
+#define POSITION_FILE_H
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Board.h"
+#ifdef CHESS_ZLIB
+#include <zlib.h>
+#endif
+
+// Streams of PackedPosition records on disk. The file is a header followed by blocks,
+// each a BlockHeader and its records, stored raw or zlib-compressed as a whole.
+// The writer appends block by block; the reader maps the file and walks it in place.
+
+struct PositionFileHeader
+{
+    char magic[4];              // "CPOS"
+    unsigned int version;
+    unsigned int compressed;    // 1 if blocks are zlib streams
+    unsigned int blockRecords;  // Records per full block
+};
+
+struct BlockHeader
+{
+    unsigned int records;
+    unsigned int bytes;        // Stored size of the block that follows
+    unsigned int reserved[2];  // Pads the header to 16 bytes, keeping raw records aligned in the mapping
+};
+
+inline bool positionCompressionAvailable()
+{
+#ifdef CHESS_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+class PositionWriter
+{
+private:
+    FILE *file = nullptr;
+    bool compressed = false;
+    std::vector<PackedPosition> block;
+    std::vector<unsigned char> scratch;
+    size_t blockRecords = 0;
+    unsigned long long written = 0;
+
+    bool flushBlock()
+    {
+        if (block.empty()) return true;
+        BlockHeader header = {(unsigned int)block.size(), (unsigned int)(block.size() * sizeof(PackedPosition)), {0, 0}};
+        const void *data = block.data();
+#ifdef CHESS_ZLIB
+        if (compressed)
+        {
+            uLongf size = compressBound(header.bytes);
+            scratch.resize(size);
+            if (compress2(scratch.data(), &size, (const Bytef *)block.data(), header.bytes, Z_BEST_SPEED) != Z_OK)
+                return false;
+            header.bytes = (unsigned int)size;
+            data = scratch.data();
+        }
+#endif
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(data, 1, header.bytes, file) == header.bytes;
+        block.clear();
+        return ok;
+    }
+
+public:
+    ~PositionWriter()
+    {
+        close();
+    }
+
+    bool open(const std::string &path, bool compress = false, size_t recordsPerBlock = 4096)
+    {
+        // Compression needs the build to have found zlib
+        close();
+        if (compress && !positionCompressionAvailable()) return false;
+        file = fopen(path.c_str(), "wb");
+        if (!file) return false;
+        compressed = compress;
+        blockRecords = std::max<size_t>(1, recordsPerBlock);
+        block.reserve(blockRecords);
+        written = 0;
+
+        PositionFileHeader header = {{'C', 'P', 'O', 'S'}, 1, compressed ? 1u : 0u, (unsigned int)blockRecords};
+        return fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+
+    bool write(const PackedPosition &p)
+    {
+        block.push_back(p);
+        ++written;
+        return block.size() < blockRecords || flushBlock();
+    }
+
+    bool close()
+    {
+        if (!file) return true;
+        bool ok = flushBlock();
+        ok = fclose(file) == 0 && ok;
+        file = nullptr;
+        return ok;
+    }
+
+    unsigned long long count()
+    {
+        return written;
+    }
+};
+
+class PositionReader
+{
+private:
+    const unsigned char *data = nullptr;
+    size_t size = 0, offset = 0;
+    bool compressed = false;
+    std::vector<PackedPosition> block;   // Decompressed block; raw blocks are read straight from the mapping
+    const PackedPosition *records = nullptr;
+    size_t blockCount = 0, blockIndex = 0;
+
+    bool nextBlock()
+    {
+        // Headers are copied out since blocks after a compressed one need not be aligned;
+        // a raw file only ever has 16-byte steps, so its records are used in place
+        BlockHeader header;
+        if (offset + sizeof(header) > size) return false;
+        memcpy(&header, data + offset, sizeof(header));
+        offset += sizeof(header);
+        if (header.bytes > size - offset || header.records == 0) return false;
+        const unsigned char *payload = data + offset;
+        offset += header.bytes;
+
+        if (!compressed)
+        {
+            if (header.bytes != header.records * sizeof(PackedPosition)) return false;
+            records = (const PackedPosition *)payload;
+        }
+        else
+        {
+#ifdef CHESS_ZLIB
+            block.resize(header.records);
+            uLongf length = header.records * sizeof(PackedPosition);
+            if (uncompress((Bytef *)block.data(), &length, payload, header.bytes) != Z_OK ||
+                length != header.records * sizeof(PackedPosition))
+                return false;
+            records = block.data();
+#else
+            return false;
+#endif
+        }
+        blockCount = header.records;
+        blockIndex = 0;
+        return true;
+    }
+
+public:
+    ~PositionReader()
+    {
+        close();
+    }
+
+    bool open(const std::string &path)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(PositionFileHeader))
+        {
+            ::close(fd);
+            return false;
+        }
+        void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+        madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+        data = (const unsigned char *)mapped;
+        size = st.st_size;
+
+        PositionFileHeader header;
+        memcpy(&header, data, sizeof(header));
+        if (memcmp(header.magic, "CPOS", 4) != 0 || header.version != 1)
+        {
+            close();
+            return false;
+        }
+        compressed = header.compressed != 0;
+        offset = sizeof(header);
+        return true;
+    }
+
+    bool next(PackedPosition &out)
+    {
+        if (blockIndex == blockCount && !nextBlock()) return false;
+        out = records[blockIndex++];
+        return true;
+    }
+
+    void close()
+    {
+        if (data) munmap((void *)data, size);
+        data = nullptr;
+        size = offset = blockCount = blockIndex = 0;
+    }
+};
+
+#endif
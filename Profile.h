@@ -0,0 +1,116 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+// Call counts and cumulative time for the Board hot paths.
+// Build with -DCHESS_PROFILE (cmake -DCHESS_PROFILE=ON) to enable; otherwise
+// PROFILE_SCOPE expands to nothing and costs nothing.
+// Times are inclusive: isCheck includes the canPieceAttack calls it makes.
+
+#ifdef CHESS_PROFILE
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum ProfileSection
+{
+    PROFILE_MOVE_PIECE,
+    PROFILE_IS_CHECK,
+    PROFILE_CAN_PIECE_ATTACK,
+    PROFILE_IS_CHECKMATE,
+    PROFILE_IS_STALEMATE,
+    PROFILE_SECTIONS
+};
+
+inline unsigned long long profileTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct ProfileTotals
+{
+    unsigned long long calls[PROFILE_SECTIONS] = {};
+    unsigned long long ticks[PROFILE_SECTIONS] = {};
+};
+
+class ProfileReport
+{
+    // Process-wide totals; each thread adds its counters when it exits,
+    // and the table is printed to stderr when the program ends
+private:
+    ProfileTotals totals;
+    std::mutex lock;
+
+public:
+    void add(const ProfileTotals &t)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (int i = 0; i < PROFILE_SECTIONS; ++i)
+        {
+            totals.calls[i] += t.calls[i];
+            totals.ticks[i] += t.ticks[i];
+        }
+    }
+
+    ~ProfileReport()
+    {
+        static const char *names[PROFILE_SECTIONS] = {"movePiece", "isCheck", "canPieceAttack", "isCheckmate", "isStalemate"};
+#if defined(__x86_64__) || defined(__i386__)
+        const char *unit = "cycles";
+#else
+        const char *unit = "ns";
+#endif
+        std::fprintf(stderr, "\n%-16s %14s %18s %14s\n", "function", "calls", unit, "per call");
+        for (int i = 0; i < PROFILE_SECTIONS; ++i)
+        {
+            double perCall = totals.calls[i] ? (double)totals.ticks[i] / totals.calls[i] : 0.0;
+            std::fprintf(stderr, "%-16s %14llu %18llu %14.1f\n", names[i], totals.calls[i], totals.ticks[i], perCall);
+        }
+    }
+};
+
+inline ProfileReport profileReport;
+
+struct ProfileCounters : ProfileTotals
+{
+    ~ProfileCounters()
+    {
+        profileReport.add(*this);
+    }
+};
+
+inline thread_local ProfileCounters profileCounters;
+
+class ProfileScope
+{
+private:
+    ProfileSection section;
+    unsigned long long start;
+
+public:
+    ProfileScope(ProfileSection s) : section(s), start(profileTicks()) {}
+
+    ~ProfileScope()
+    {
+        profileCounters.calls[section] += 1;
+        profileCounters.ticks[section] += profileTicks() - start;
+    }
+};
+
+#define PROFILE_SCOPE(section) ProfileScope profileScope(section)
+
+#else
+
+#define PROFILE_SCOPE(section) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,674 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include "Board.h"
+
+const int MAX_PLY = 64;
+
+struct SearchTables
+{
+    // Move ordering state for one search thread, stored as flat arrays
+    Move killers[MAX_PLY * 2];        // [ply][slot]
+    int history[2 * 64 * 64];         // [color][from][to]
+    Move counterMoves[12 * 64];       // [previous piece][previous to-square]
+
+    SearchTables()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        std::fill(killers, killers + MAX_PLY * 2, Move());
+        std::fill(history, history + 2 * 64 * 64, 0);
+        std::fill(counterMoves, counterMoves + 12 * 64, Move());
+    }
+
+    void age()
+    {
+        // Called between searches: killers belong to the old tree, history only fades
+        std::fill(killers, killers + MAX_PLY * 2, Move());
+        for (int &h : history) h /= 2;
+    }
+
+    static bool sameMove(const Move &a, const Move &b)
+    {
+        return a.sx == b.sx && a.sy == b.sy && a.ex == b.ex && a.ey == b.ey && a.promotion == b.promotion;
+    }
+
+    int &historyFor(Color turn, const Move &m)
+    {
+        return history[(turn == BLACK ? 64 * 64 : 0) + (m.sx * 8 + m.sy) * 64 + m.ex * 8 + m.ey];
+    }
+
+    Move *counterFor(const Board &board, const Move &prev)
+    {
+        // The previous move has already been played, so its piece stands on the to-square.
+        // A Chess960 castle names the rook's square, often empty afterwards: no slot then.
+        if (prev.sx < 0) return nullptr;
+        int piece = pieceIndex(board.pieceAt(prev.ex, prev.ey));
+        if (piece < 0) return nullptr;
+        return &counterMoves[piece * 64 + prev.ex * 8 + prev.ey];
+    }
+
+    void recordCutoff(const Board &board, Color turn, const Move &m, const Move &prev, int depth, int ply)
+    {
+        // Only quiet moves go into the tables; captures are already ordered by MVV-LVA
+        if (!sameMove(killers[ply * 2], m))
+        {
+            killers[ply * 2 + 1] = killers[ply * 2];
+            killers[ply * 2] = m;
+        }
+
+        int &h = historyFor(turn, m);
+        h += depth * depth;
+        if (h > 1000000) age();
+
+        if (Move *counter = counterFor(board, prev)) *counter = m;
+    }
+};
+
+enum Bound { BOUND_NONE, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT };
+
+struct TTEntry
+{
+    unsigned long long key = 0;
+    int score = 0;
+    signed char depth = 0;
+    unsigned char bound = BOUND_NONE;
+    signed char sx = -1, sy = -1, ex = -1, ey = -1;  // Best or refuting move
+    char promotion = ' ';
+
+    Move move() const
+    {
+        return Move(sx, sy, ex, ey, promotion);
+    }
+};
+
+class TranspositionTable
+{
+    // Scores of searched positions by Zobrist key, one entry per slot. A slot keeps
+    // its deeper result for the same position and is overwritten by any other one.
+private:
+    std::vector<TTEntry> entries;
+    size_t mask = 0;
+
+public:
+    void resize(size_t megabytes)
+    {
+        size_t size = 1;
+        while (size * 2 * sizeof(TTEntry) <= megabytes * 1024 * 1024) size *= 2;
+        if (size == entries.size()) return;
+        entries.assign(size, TTEntry());
+        mask = size - 1;
+    }
+
+    void clear()
+    {
+        std::fill(entries.begin(), entries.end(), TTEntry());
+    }
+
+    const TTEntry *probe(unsigned long long key) const
+    {
+        if (entries.empty()) return nullptr;
+        const TTEntry &e = entries[key & mask];
+        return (e.key == key && e.bound != BOUND_NONE) ? &e : nullptr;
+    }
+
+    void store(unsigned long long key, int depth, int score, Bound bound, const Move &m)
+    {
+        if (entries.empty()) return;
+        TTEntry &e = entries[key & mask];
+        if (e.key == key && e.depth > depth && bound != BOUND_EXACT) return;
+        e.key = key;
+        e.score = score;
+        e.depth = (signed char)depth;
+        e.bound = (unsigned char)bound;
+        e.sx = m.sx;
+        e.sy = m.sy;
+        e.ex = m.ex;
+        e.ey = m.ey;
+        e.promotion = m.promotion;
+    }
+
+    // Mate scores are stored relative to the node, not the root
+    static int toTable(int score, int ply)
+    {
+        if (score >= MATE_SCORE - MAX_PLY) return score + ply;
+        if (score <= -MATE_SCORE + MAX_PLY) return score - ply;
+        return score;
+    }
+
+    static int fromTable(int score, int ply)
+    {
+        if (score >= MATE_SCORE - MAX_PLY) return score - ply;
+        if (score <= -MATE_SCORE + MAX_PLY) return score + ply;
+        return score;
+    }
+};
+
+struct PvLine
+{
+    // One line of a Multi-PV analysis
+    Move move;
+    std::vector<Move> line;
+    int score = 0, depth = 0;
+    long long nodes = 0, timeMs = 0;
+};
+
+struct SearchOptions
+{
+    // Selectivity switches, settable at runtime by name for A/B testing
+    bool nullMove = true;
+    int nullMoveReduction = 2;
+    bool lateMoveReductions = true;
+    int lmrMinDepth = 3;
+    int lmrMinMoves = 4;
+    bool futility = true;
+    int futilityMargin = 150;
+    bool razoring = true;
+    int razorMargin = 300;
+    bool checkExtensions = true;
+    int hashMb = 16;          // Transposition table size, 0 to search without one
+    int aspirationWindow = 50;
+
+    bool set(const std::string &name, const std::string &value)
+    {
+        std::map<std::string, bool *> flags = {
+            {"nullmove", &nullMove}, {"lmr", &lateMoveReductions}, {"futility", &futility},
+            {"razoring", &razoring}, {"checkext", &checkExtensions}};
+        std::map<std::string, int *> numbers = {
+            {"nullmove_r", &nullMoveReduction}, {"lmr_depth", &lmrMinDepth}, {"lmr_moves", &lmrMinMoves},
+            {"futility_margin", &futilityMargin}, {"razor_margin", &razorMargin}, {"hash", &hashMb},
+            {"aspiration", &aspirationWindow}};
+
+        if (flags.count(name))
+        {
+            *flags[name] = (value == "on" || value == "true" || value == "1");
+            return true;
+        }
+        if (numbers.count(name))
+        {
+            *numbers[name] = std::atoi(value.c_str());
+            return true;
+        }
+        return false;  // Unknown option
+    }
+};
+
+class TimeManager
+{
+    // Turns the clock into a per-move budget: an optimum time the search aims for
+    // and a hard maximum it may never pass
+private:
+    // The limits are atomic because a ponder hit switches them on from another thread
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<long long> optimumMs{0};
+    std::atomic<long long> maximumMs{0};
+    std::atomic<bool> limited{false};
+
+    void setBudget(long long remainingMs, long long incrementMs, int movesToGo, long long alreadyUsedMs)
+    {
+        // Assume 30 more moves in sudden death, and never plan past the clock minus overhead
+        int moves = (movesToGo > 0) ? std::min(movesToGo, 50) : 30;
+        long long available = std::max(1LL, remainingMs - MOVE_OVERHEAD);
+
+        long long optimum = available / moves + incrementMs * 3 / 4;
+        long long maximum = std::min(available * 4 / 5, optimum * 5);
+        if (movesToGo == 1) maximum = available;  // Last move before the control
+        optimum = std::max(1LL, std::min(optimum, maximum));
+        maximum = std::max(optimum, maximum);
+
+        // Time spent before the clock started (pondering) is free
+        optimumMs = optimum + alreadyUsedMs;
+        maximumMs = maximum + alreadyUsedMs;
+        limited = true;
+    }
+
+public:
+    static const int POLL_NODES = 512;   // Nodes between clock reads
+    static const int MOVE_OVERHEAD = 50; // Milliseconds kept back for I/O lag
+
+    void start(long long remainingMs, long long incrementMs = 0, int movesToGo = 0)
+    {
+        startTime = std::chrono::steady_clock::now();
+        setBudget(remainingMs, incrementMs, movesToGo, 0);
+    }
+
+    void ponderHit(long long remainingMs, long long incrementMs = 0, int movesToGo = 0)
+    {
+        // The running infinite search becomes a timed one; our clock starts now
+        setBudget(remainingMs, incrementMs, movesToGo, elapsed());
+    }
+
+    void stopNow()
+    {
+        maximumMs = 0;
+        optimumMs = 0;
+        limited = true;
+    }
+
+    void startFixed(long long moveTimeMs)
+    {
+        startTime = std::chrono::steady_clock::now();
+        limited = true;
+        optimumMs = maximumMs = std::max(1LL, moveTimeMs - MOVE_OVERHEAD);
+    }
+
+    void startInfinite()
+    {
+        startTime = std::chrono::steady_clock::now();
+        limited = false;
+    }
+
+    long long elapsed()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    bool isLimited()
+    {
+        return limited;
+    }
+
+    bool hardLimitReached()
+    {
+        return limited && elapsed() >= maximumMs;
+    }
+
+    bool softLimitReached(int bestMoveChanges, int stableIterations)
+    {
+        // Checked between iterations: spend more while the best move keeps changing,
+        // less once the same move has won several iterations in a row
+        if (!limited) return false;
+
+        long long target = optimumMs;
+        if (bestMoveChanges > 0) target = target * (10 + 5 * std::min(bestMoveChanges, 4)) / 10;
+        else if (stableIterations >= 4) target = target / 2;
+
+        // An iteration costs several times the last one, so don't start one we can't finish
+        return elapsed() >= std::min(target, maximumMs.load()) * 6 / 10;
+    }
+};
+
+class Search
+{
+public:
+    long long nodes = 0;
+    long long nodeLimit = 0;  // Stop once this many nodes are searched, 0 for no limit
+    SearchOptions options;
+    SearchTables tables;
+    TimeManager timer;
+    Move bestMove;
+    std::vector<Move> bestLine;  // Principal variation of the last finished iteration
+    int bestScore = 0;
+    int completedDepth = 0;
+    std::vector<PvLine> lines;  // Multi-PV results of the last finished iteration, best first
+    std::function<void(Search &)> onIteration;  // Called after each finished iteration, if set
+    TranspositionTable tt;
+
+    void stop()
+    {
+        // Safe to call from another thread. The timer is also expired so a search
+        // that has not reached its first poll yet still winds down.
+        timer.stopNow();
+        stopped = true;
+    }
+
+    Move think(Board &board, Color turn, int maxDepth)
+    {
+        // Iterative deepening; the ordering tables carry over between iterations.
+        // Start the timer first for a timed search, otherwise call timer.startInfinite().
+        prepare();
+        int stableIterations = 0;
+        for (rootDepth = 1; rootDepth <= maxDepth && rootDepth < MAX_PLY; ++rootDepth)
+        {
+            int score = aspirationSearch(board, turn, bestScore);
+            if (stopped) break;  // Unfinished iteration, keep the previous result
+
+            int bestMoveChanges = (bestMove.sx >= 0 && !SearchTables::sameMove(iterationBest, bestMove)) ? 1 : 0;
+            stableIterations = bestMoveChanges ? 0 : stableIterations + 1;
+            bestMove = iterationBest;
+            bestLine.assign(pvTable, pvTable + pvLength[0]);
+            bestScore = score;
+            completedDepth = rootDepth;
+            if (onIteration) onIteration(*this);
+
+            if (timer.isLimited() && abs(score) >= MATE_SCORE - MAX_PLY) break;  // Forced mate found
+
+            // Only one legal reply: nothing to think about
+            if (timer.isLimited() && rootDepth == 1 && board.countLegalMoves(turn) == 1) break;
+            if (timer.softLimitReached(bestMoveChanges, stableIterations)) break;
+        }
+        return bestMove;
+    }
+
+    std::vector<PvLine> analyze(Board &board, Color turn, int maxDepth, int multiPv)
+    {
+        // The best multiPv root moves with their lines. Each depth searches the root again
+        // with the moves already listed left out, so line k is the best move not in lines 0..k-1.
+        // The lines share the transposition table, and each starts from an aspiration
+        // window around its own score from the previous depth.
+        // Start the timer first, as for think().
+        prepare();
+        lines.clear();
+        multiPv = std::max(1, std::min(multiPv, board.countLegalMoves(turn)));
+
+        for (rootDepth = 1; rootDepth <= maxDepth && rootDepth < MAX_PLY; ++rootDepth)
+        {
+            std::vector<PvLine> current;
+            rootExcluded.clear();
+            for (int k = 0; k < multiPv; ++k)
+            {
+                int guess = (k < (int)lines.size()) ? lines[k].score : (current.empty() ? 0 : current.back().score);
+                int score = aspirationSearch(board, turn, guess);
+                if (stopped || iterationBest.sx < 0) break;
+
+                PvLine line;
+                line.move = iterationBest;
+                line.line.assign(pvTable, pvTable + pvLength[0]);
+                line.score = score;
+                line.depth = rootDepth;
+                line.nodes = nodes;
+                line.timeMs = timer.elapsed();
+                current.push_back(line);
+                rootExcluded.push_back(iterationBest);
+            }
+            if (stopped) break;  // Unfinished depth, keep the previous lines
+
+            std::stable_sort(current.begin(), current.end(), [](const PvLine &a, const PvLine &b) { return a.score > b.score; });
+            lines = current;
+            bestMove = lines[0].move;
+            bestLine = lines[0].line;
+            bestScore = lines[0].score;
+            completedDepth = rootDepth;
+            if (onIteration) onIteration(*this);
+            if (timer.softLimitReached(0, 0)) break;
+        }
+        rootExcluded.clear();
+        return lines;
+    }
+
+    void orderMoves(Board &board, std::vector<Move> &moves, Color turn, int ply, const Move &prev, const Move &ttMove = Move())
+    {
+        // Reads go through a const view, so the board's cached state survives ordering
+        const Board &position = board;
+        Move *slot = tables.counterFor(position, prev);
+        Move counter = slot ? *slot : Move();
+
+        for (Move &m : moves)
+        {
+            if (SearchTables::sameMove(m, ttMove)) m.score = 3000000;
+            else if (position.isCapture(m))
+            {
+                char victim = position.pieceAt(m.ex, m.ey).type;
+                m.score = 2000000 + 10 * pieceValue(victim == ' ' ? 'P' : victim) - pieceValue(position.pieceAt(m.sx, m.sy).type);
+            }
+            else if (m.promotion != ' ') m.score = 1900000 + pieceValue(m.promotion);
+            else if (SearchTables::sameMove(m, tables.killers[ply * 2])) m.score = 1800000;
+            else if (SearchTables::sameMove(m, tables.killers[ply * 2 + 1])) m.score = 1700000;
+            else if (SearchTables::sameMove(m, counter)) m.score = 1600000;
+            else m.score = tables.historyFor(turn, m);
+        }
+
+        std::stable_sort(moves.begin(), moves.end(), [](const Move &a, const Move &b) { return a.score > b.score; });
+    }
+
+    int alphaBeta(Board &board, Color turn, int depth, int alpha, int beta, int ply, const Move &prev, bool allowNull = true)
+    {
+        // countNode polls the clock; depth 1 always finishes so there is a move
+        if (rootDepth > 1 && nodeLimit && nodes >= nodeLimit) stopped = true;
+        if (stopped) return 0;
+
+        Color enemy = (turn == WHITE ? BLACK : WHITE);
+        bool inCheck = board.isCheck(turn);
+        if (inCheck && options.checkExtensions) ++depth;
+
+        pvLength[ply] = ply;
+        if (depth <= 0 || ply >= MAX_PLY - 1) return quiescence(board, turn, alpha, beta);
+        countNode();
+
+        bool pvNode = beta - alpha > 1;
+        int originalAlpha = alpha;
+
+        // A deep enough stored result settles a non-PV node; otherwise its move goes first
+        unsigned long long key = board.hash(turn);
+        const TTEntry *entry = tt.probe(key);
+        Move ttMove = entry ? entry->move() : Move();
+        if (entry && ply > 0 && !pvNode && entry->depth >= depth)
+        {
+            int stored = TranspositionTable::fromTable(entry->score, ply);
+            if (entry->bound == BOUND_EXACT) return std::max(alpha, std::min(beta, stored));
+            if (entry->bound == BOUND_LOWER && stored >= beta) return beta;
+            if (entry->bound == BOUND_UPPER && stored <= alpha) return alpha;
+        }
+        int staticEval = board.evaluate(turn);
+
+        // Razoring: far below alpha near the leaves, let quiescence decide
+        if (options.razoring && !pvNode && !inCheck && depth <= 2 && staticEval + options.razorMargin * depth <= alpha)
+        {
+            int score = quiescence(board, turn, alpha, beta);
+            if (score <= alpha) return score;
+        }
+
+        // Null move: if passing still fails high, a real move will too
+        if (options.nullMove && allowNull && !pvNode && !inCheck && depth >= 3 && staticEval >= beta &&
+            board.hasNonPawnMaterial(turn))
+        {
+            std::pair<int, int> saved = board.makeNullMove();
+            int score = -alphaBeta(board, enemy, depth - 1 - options.nullMoveReduction, -beta, -beta + 1, ply + 1, Move(), false);
+            board.unmakeNullMove(saved);
+            if (score >= beta) return beta;
+        }
+
+        // Futility: quiet moves cannot lift a hopeless static eval above alpha
+        bool futile = options.futility && !pvNode && !inCheck && depth <= 2 &&
+                      staticEval + options.futilityMargin * depth <= alpha;
+
+        std::vector<Move> moves = board.generateMoves(turn);
+        orderMoves(board, moves, turn, ply, prev, ttMove);
+
+        int legalMoves = 0;
+        Move best;
+        for (Move &m : moves)
+        {
+            if (ply == 0 && std::any_of(rootExcluded.begin(), rootExcluded.end(),
+                                        [&m](const Move &x) { return SearchTables::sameMove(x, m); }))
+                continue;
+            BoardArena arena;
+            Board child = board;
+            if (!child.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion)) continue;
+            ++legalMoves;
+
+            bool quiet = !board.isCapture(m) && m.promotion == ' ';
+            bool givesCheck = (futile || options.lateMoveReductions) && quiet && child.isCheck(enemy);
+            if (futile && quiet && legalMoves > 1 && !givesCheck) continue;
+
+            int score;
+            if (options.lateMoveReductions && quiet && !inCheck && !givesCheck &&
+                depth >= options.lmrMinDepth && legalMoves > options.lmrMinMoves)
+            {
+                // Late quiet moves get a reduced null-window look first
+                int reduction = (legalMoves > 2 * options.lmrMinMoves) ? 2 : 1;
+                score = -alphaBeta(child, enemy, depth - 1 - reduction, -alpha - 1, -alpha, ply + 1, m);
+                if (score > alpha) score = -alphaBeta(child, enemy, depth - 1, -beta, -alpha, ply + 1, m);
+            } else
+            {
+                score = -alphaBeta(child, enemy, depth - 1, -beta, -alpha, ply + 1, m);
+            }
+            if (stopped) return 0;
+
+            if (score > alpha)
+            {
+                alpha = score;
+                best = m;
+                if (ply == 0) iterationBest = m;
+
+                // Extend the principal variation with the child's line
+                pvTable[ply * MAX_PLY + ply] = m;
+                for (int k = ply + 1; k < pvLength[ply + 1]; ++k) pvTable[ply * MAX_PLY + k] = pvTable[(ply + 1) * MAX_PLY + k];
+                pvLength[ply] = std::max(ply + 1, pvLength[ply + 1]);
+            }
+            if (alpha >= beta)
+            {
+                if (quiet) tables.recordCutoff(board, turn, m, prev, depth, ply);
+                tt.store(key, depth, TranspositionTable::toTable(beta, ply), BOUND_LOWER, m);
+                return beta;
+            }
+        }
+
+        // No legal moves: checkmate (prefer the shortest) or stalemate.
+        // At the root of a Multi-PV search the other moves may just be excluded.
+        if (legalMoves == 0 && (ply > 0 || rootExcluded.empty())) return inCheck ? -MATE_SCORE + ply : 0;
+        if (ply > 0 || rootExcluded.empty())
+            tt.store(key, depth, TranspositionTable::toTable(alpha, ply), alpha > originalAlpha ? BOUND_EXACT : BOUND_UPPER, best);
+        return alpha;
+    }
+
+    int quiescence(Board &board, Color turn, int alpha, int beta)
+    {
+        // Only resolve captures and promotions so the static eval is taken at a quiet position
+        countNode();
+
+        int standPat = board.evaluate(turn);
+        if (standPat >= beta) return beta;
+        if (standPat > alpha) alpha = standPat;
+
+        std::vector<Move> captures = board.generateCaptures(turn);
+        for (Move &m : captures)
+        {
+            // Skip captures that lose material once all recaptures are played out
+            if (board.staticExchange(m, turn) < 0) continue;
+
+            BoardArena arena;
+            Board child = board;
+            if (!child.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion)) continue;
+
+            int score = -quiescence(child, (turn == WHITE ? BLACK : WHITE), -beta, -alpha);
+            if (score >= beta) return beta;
+            if (score > alpha) alpha = score;
+        }
+
+        return alpha;
+    }
+
+private:
+    std::atomic<bool> stopped{false};
+    int rootDepth = 0;
+    int pollCountdown = TimeManager::POLL_NODES;  // Nodes left until the next clock read
+    Move iterationBest;
+    std::vector<Move> rootExcluded;  // Root moves already taken by earlier Multi-PV lines
+
+    void countNode()
+    {
+        // Both searches count here, so the clock is read every POLL_NODES nodes exactly
+        ++nodes;
+        if (--pollCountdown > 0) return;
+        pollCountdown = TimeManager::POLL_NODES;
+        if (rootDepth > 1 && timer.hardLimitReached()) stopped = true;
+    }
+
+    void prepare()
+    {
+        tables.age();
+        tt.resize(options.hashMb);
+        nodes = 0;
+        pollCountdown = TimeManager::POLL_NODES;
+        stopped = false;
+        bestMove = Move();
+        bestLine.clear();
+        bestScore = 0;
+        completedDepth = 0;
+    }
+
+    int aspirationSearch(Board &board, Color turn, int guess)
+    {
+        // Search the root in a narrow window around the expected score, widening the
+        // side that fails until the score lands inside. Shallow depths use the full window.
+        int delta = options.aspirationWindow;
+        bool narrow = delta > 0 && rootDepth >= 4 && abs(guess) < MATE_SCORE - MAX_PLY;
+        int alpha = narrow ? guess - delta : -MATE_SCORE, beta = narrow ? guess + delta : MATE_SCORE;
+        while (true)
+        {
+            iterationBest = Move();
+            int score = alphaBeta(board, turn, rootDepth, alpha, beta, 0, Move());
+            if (stopped) return score;
+            if (score <= alpha && alpha > -MATE_SCORE) alpha = std::max(-MATE_SCORE, alpha - delta);
+            else if (score >= beta && beta < MATE_SCORE) beta = std::min(MATE_SCORE, beta + delta);
+            else return score;
+            delta *= 2;
+        }
+    }
+    Move pvTable[MAX_PLY * MAX_PLY];  // Triangular: row ply holds the line from ply onwards
+    int pvLength[MAX_PLY] = {};       // End index of each row
+};
+
+class Ponder
+{
+    // Searches the position after the expected reply on a background thread while
+    // the opponent is thinking. On a hit the search keeps running under a real clock.
+private:
+    Search &search;
+    Board board;
+    Move expected;
+    std::thread worker;
+    bool running = false;
+
+public:
+    Ponder(Search &s) : search(s) {}
+
+    ~Ponder()
+    {
+        cancel();
+    }
+
+    void start(const Board &predicted, Color turn, const Move &reply)
+    {
+        cancel();
+        board = predicted;
+        expected = reply;
+        running = true;
+        search.timer.startInfinite();
+        worker = std::thread([this, turn]() { search.think(board, turn, MAX_PLY); });
+    }
+
+    bool isRunning()
+    {
+        return running;
+    }
+
+    bool hit(const Move &played, long long remainingMs, long long incrementMs = 0, int movesToGo = 0)
+    {
+        // A miss throws the ponder search away; a hit hands it the clock
+        if (!running) return false;
+        if (!SearchTables::sameMove(played, expected))
+        {
+            cancel();
+            return false;
+        }
+        search.timer.ponderHit(remainingMs, incrementMs, movesToGo);
+        return true;
+    }
+
+    Move finish()
+    {
+        // Wait for the converted search to use its budget and return its move
+        worker.join();
+        running = false;
+        return search.bestMove;
+    }
+
+    void cancel()
+    {
+        if (!running) return;
+        search.stop();
+        worker.join();
+        running = false;
+    }
+};
+
+#endif
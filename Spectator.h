@@ -0,0 +1,114 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include <cstdio>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Board updates for spectators, built from Board::squareCodes arrays. After one full
+// frame a spectator only gets the squares a move changed: as ANSI cursor writes for a
+// terminal, or as a compact "e4P e2." record for programs.
+
+struct SquareCodes
+{
+    alignas(16) char codes[64];
+};
+
+inline unsigned long long changedSquares(const SquareCodes &before, const SquareCodes &after)
+{
+    // Bit (row * 8 + col) set for each square whose code differs
+#ifdef __SSE2__
+    unsigned long long same = 0;
+    for (int k = 0; k < 4; ++k)
+    {
+        __m128i a = _mm_load_si128((const __m128i *)(before.codes + 16 * k));
+        __m128i b = _mm_load_si128((const __m128i *)(after.codes + 16 * k));
+        same |= (unsigned long long)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) << (16 * k);
+    }
+    return ~same;
+#else
+    unsigned long long changed = 0;
+    for (int sq = 0; sq < 64; ++sq)
+        if (before.codes[sq] != after.codes[sq]) changed |= 1ULL << sq;
+    return changed;
+#endif
+}
+
+// Terminal layout of ansiFrame: rank 8 is on this line, and each square is three
+// columns wide after the rank label
+const int SPECTATOR_FIRST_ROW = 2;
+const int SPECTATOR_FIRST_COL = 3;
+const int SPECTATOR_FRAME_SIZE = 512;
+
+inline char *writeCell(char *p, char code)
+{
+    bool white = code >= 'A' && code <= 'Z';
+    if (code == '.')
+    {
+        memcpy(p, " . ", 3);
+        return p + 3;
+    }
+    p[0] = white ? '[' : '(';
+    p[1] = char(white ? code : code - 'a' + 'A');
+    p[2] = white ? ']' : ')';
+    return p + 3;
+}
+
+inline int ansiFrame(const SquareCodes &board, char *out)
+{
+    // Clear the screen and draw everything
+    static const char header[] = "   A  B  C  D  E  F  G  H\n";
+    char *p = out;
+    memcpy(p, "\x1b[H\x1b[2J", 7);
+    p += 7;
+    memcpy(p, header, sizeof(header) - 1);
+    p += sizeof(header) - 1;
+    for (int i = 0; i < 8; ++i)
+    {
+        *p++ = char('0' + 8 - i);
+        *p++ = ' ';
+        for (int j = 0; j < 8; ++j) p = writeCell(p, board.codes[i * 8 + j]);
+        *p++ = ' ';
+        *p++ = char('0' + 8 - i);
+        *p++ = '\n';
+    }
+    memcpy(p, header, sizeof(header) - 1);
+    p += sizeof(header) - 1;
+    return int(p - out);
+}
+
+inline int ansiDelta(const SquareCodes &board, unsigned long long changed, char *out)
+{
+    // A cursor move only where the next changed square doesn't directly follow the last one
+    char *p = out;
+    int last = -2;
+    for (; changed; changed &= changed - 1)
+    {
+        int sq = __builtin_ctzll(changed);
+        if (sq != last + 1 || sq % 8 == 0)
+            p += sprintf(p, "\x1b[%d;%dH", SPECTATOR_FIRST_ROW + sq / 8, SPECTATOR_FIRST_COL + 3 * (sq % 8));
+        p = writeCell(p, board.codes[sq]);
+        last = sq;
+    }
+    return int(p - out);
+}
+
+inline int compactDelta(const SquareCodes &board, unsigned long long changed, char *out)
+{
+    // "e4P e2.": square, then its new code, in square order (rank 8 to rank 1, a to h),
+    // so a move's from- and to-squares can come either way round; no trailing separator
+    char *p = out;
+    for (; changed; changed &= changed - 1)
+    {
+        int sq = __builtin_ctzll(changed);
+        if (p != out) *p++ = ' ';
+        *p++ = char('a' + sq % 8);
+        *p++ = char('0' + 8 - sq / 8);
+        *p++ = board.codes[sq];
+    }
+    return int(p - out);
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef VALIDATE_H
+#define VALIDATE_H
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+
+// Checks many candidate moves against a position with one legal-move generation,
+// instead of one movePiece call per candidate.
+
+struct LegalMoveSet
+{
+    unsigned long long targets[64] = {};  // [from square] -> bit per legal to-square
+
+    void build(Board &board, Color turn)
+    {
+        // Made and unmade in place; the four promotions of one pawn move mark the same bit
+        for (Move &m : legalMoves(board, turn)) targets[m.sx * 8 + m.sy] |= 1ULL << (m.ex * 8 + m.ey);
+    }
+
+    bool contains(const Board &board, const Move &m) const
+    {
+        if (!board.isInsideBoard(m.sx, m.sy) || !board.isInsideBoard(m.ex, m.ey)) return false;
+        if (!(targets[m.sx * 8 + m.sy] >> (m.ex * 8 + m.ey) & 1)) return false;
+
+        // A pawn reaching the last rank needs a promotion piece (' ' means queen), nothing else may have one
+        bool promoting = board.pieceAt(m.sx, m.sy).type == 'P' && (m.ex == 0 || m.ex == 7);
+        if (promoting) return m.promotion == ' ' || (m.promotion != '\0' && strchr("QRBN", m.promotion) != nullptr);
+        return m.promotion == ' ';
+    }
+};
+
+inline std::vector<bool> validateMoves(Board &board, Color turn, const std::vector<Move> &candidates)
+{
+    LegalMoveSet legal;
+    legal.build(board, turn);
+    std::vector<bool> result(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) result[i] = legal.contains(board, candidates[i]);
+    return result;
+}
+
+inline std::vector<bool> validateMoves(const std::string &fen, const std::vector<Move> &candidates)
+{
+    // An unreadable FEN makes every candidate illegal
+    Board board;
+    Color turn;
+    if (!board.loadFen(fen, turn)) return std::vector<bool>(candidates.size(), false);
+    return validateMoves(board, turn, candidates);
+}
+
+struct ValidationRequest
+{
+    std::string fen;
+    std::vector<Move> moves;
+};
+
+inline std::vector<std::vector<bool>> validateMoves(const std::vector<ValidationRequest> &batch, int threads)
+{
+    // Positions are split into contiguous ranges, one per thread; each result has its own slot
+    std::vector<std::vector<bool>> results(batch.size());
+    threads = std::max(1, std::min(threads, (int)batch.size()));
+
+    std::vector<std::thread> pool;
+    size_t chunk = (batch.size() + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t)
+    {
+        size_t begin = t * chunk, end = std::min(batch.size(), begin + chunk);
+        pool.emplace_back([&batch, &results, begin, end]() {
+            for (size_t i = begin; i < end; ++i) results[i] = validateMoves(batch[i].fen, batch[i].moves);
+        });
+    }
+    for (std::thread &t : pool) t.join();
+    return results;
+}
+
+#endif
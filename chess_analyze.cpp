@@ -0,0 +1,57 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "Search.h"
+#include "Notation.h"
+
+// Multi-PV analysis of one position: the best N moves with score and line at each depth.
+// Usage: chess_analyze [--fen "<fen>"] [--multipv n] [--depth n] [--time ms] [--hash MB]
+
+int main(int argc, char *argv[])
+{
+    std::string fen;
+    int multiPv = 3, depth = 6;
+    long long timeMs = 0;
+    Search search;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        if (flag == "--fen") fen = argv[i + 1];
+        else if (flag == "--multipv") multiPv = atoi(argv[i + 1]);
+        else if (flag == "--depth") depth = atoi(argv[i + 1]);
+        else if (flag == "--time") timeMs = atoll(argv[i + 1]);
+        else if (flag == "--hash") search.options.hashMb = atoi(argv[i + 1]);
+        else
+        {
+            std::cerr << "Usage: chess_analyze [--fen \"<fen>\"] [--multipv n] [--depth n] [--time ms] [--hash MB]\n";
+            return 1;
+        }
+    }
+
+    Board board;
+    Color turn = WHITE;
+    if (!fen.empty() && !board.loadFen(fen, turn))
+    {
+        std::cerr << "Bad FEN: " << fen << "\n";
+        return 1;
+    }
+
+    search.onIteration = [&](Search &s) {
+        for (size_t k = 0; k < s.lines.size(); ++k)
+        {
+            PvLine &line = s.lines[k];
+            std::cout << "depth " << line.depth << " multipv " << k + 1 << " score " << line.score << " nodes "
+                      << line.nodes << " time " << line.timeMs << " pv";
+            for (Move &m : line.line) std::cout << " " << toCoordinate(m);
+            std::cout << "\n";
+        }
+    };
+    if (timeMs > 0)
+    {
+        search.timer.startFixed(timeMs);
+        depth = MAX_PLY;
+    }
+    else search.timer.startInfinite();
+    search.analyze(board, turn, depth, multiPv);
+    return 0;
+}
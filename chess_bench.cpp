@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "Validate.h"
+
+// Fixed positions shared by every benchmark, selected with ->Arg(index)
+struct BenchPosition
+{
+    const char *name;
+    Board board;
+    Color turn;
+    Move move;  // Move tried by the movePiece benchmark; rejected in the mate and stalemate positions
+};
+
+static Board playMoves(const std::vector<std::string> &moves)
+{
+    // Moves are written like "E2E4"; promotions never occur in these lines
+    Board board;
+    Color turn = WHITE;
+    for (const std::string &m : moves)
+    {
+        board.movePiece(8 - (m[1] - '0'), m[0] - 'A', 8 - (m[3] - '0'), m[2] - 'A', turn);
+        turn = (turn == WHITE ? BLACK : WHITE);
+    }
+    return board;
+}
+
+static Board stalematePosition()
+{
+    // Black king h8, white queen g6, white king a1: black to move has no legal move
+    Board board;
+    for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 8; ++j)
+            board.pieceAt(i, j) = Piece();
+    board.pieceAt(0, 7) = Piece('K', BLACK);
+    board.pieceAt(2, 6) = Piece('Q', WHITE);
+    board.pieceAt(7, 0) = Piece('K', WHITE);
+    return board;
+}
+
+static std::vector<BenchPosition> &positions()
+{
+    static std::vector<BenchPosition> list = {
+        {"start", Board(), WHITE, Move(6, 4, 4, 4)},
+        {"italian", playMoves({"E2E4", "E7E5", "G1F3", "B8C6", "F1C4", "F8C5", "C2C3", "G8F6", "D2D4", "E5D4"}),
+         WHITE, Move(5, 2, 4, 3)},
+        {"scholars_mate", playMoves({"E2E4", "E7E5", "F1C4", "B8C6", "D1H5", "G8F6", "H5F7"}), BLACK, Move(0, 4, 1, 5)},
+        {"stalemate", stalematePosition(), BLACK, Move(0, 7, 0, 6)},
+    };
+    return list;
+}
+
+static void positionArgs(benchmark::internal::Benchmark *b)
+{
+    for (int i = 0; i < (int)positions().size(); ++i) b->Arg(i);
+}
+
+static void BM_BoardCopy(benchmark::State &state)
+{
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    for (auto _ : state)
+    {
+        Board copy = pos.board;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_BoardCopy)->Apply(positionArgs);
+
+static void BM_IsCheck(benchmark::State &state)
+{
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pos.board.isCheck(pos.turn));
+    }
+}
+BENCHMARK(BM_IsCheck)->Apply(positionArgs);
+
+static void BM_CanPieceAttack(benchmark::State &state)
+{
+    // Every occupied square against all 64 targets, the pattern isCheck and the mate scans use
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    long long calls = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                Piece &p = pos.board.pieceAt(i, j);
+                if (p.color == NONE) continue;
+                for (int x = 0; x < 8; ++x)
+                {
+                    for (int y = 0; y < 8; ++y)
+                    {
+                        benchmark::DoNotOptimize(pos.board.canPieceAttack(i, j, x, y, p));
+                        ++calls;
+                    }
+                }
+            }
+        }
+    }
+    state.SetItemsProcessed(calls);
+}
+BENCHMARK(BM_CanPieceAttack)->Apply(positionArgs);
+
+static void BM_MovePiece(benchmark::State &state)
+{
+    // Includes the copy that restores the position; compare with BM_BoardCopy
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    const Move &m = pos.move;
+    for (auto _ : state)
+    {
+        Board copy = pos.board;
+        benchmark::DoNotOptimize(copy.movePiece(m.sx, m.sy, m.ex, m.ey, pos.turn, 'Q'));
+    }
+}
+BENCHMARK(BM_MovePiece)->Apply(positionArgs);
+
+static void BM_IsCheckmate(benchmark::State &state)
+{
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    for (auto _ : state)
+    {
+        pos.board.invalidate();  // Measure the scan, not the cached answer
+        benchmark::DoNotOptimize(pos.board.isCheckmate(pos.turn));
+    }
+}
+BENCHMARK(BM_IsCheckmate)->Apply(positionArgs);
+
+static void BM_IsStalemate(benchmark::State &state)
+{
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    for (auto _ : state)
+    {
+        pos.board.invalidate();  // Measure the scan, not the cached answer
+        benchmark::DoNotOptimize(pos.board.isStalemate(pos.turn));
+    }
+}
+BENCHMARK(BM_IsStalemate)->Apply(positionArgs);
+
+static void BM_ValidateMoves(benchmark::State &state)
+{
+    // Every from/to pair as a candidate: one generation, then a bit test per candidate
+    BenchPosition &pos = positions()[state.range(0)];
+    state.SetLabel(pos.name);
+    std::vector<Move> candidates;
+    for (int from = 0; from < 64; ++from)
+        for (int to = 0; to < 64; ++to) candidates.push_back(Move(from / 8, from % 8, to / 8, to % 8));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(validateMoves(pos.board, pos.turn, candidates));
+    }
+    state.SetItemsProcessed(state.iterations() * candidates.size());
+}
+BENCHMARK(BM_ValidateMoves)->Apply(positionArgs);
+
+BENCHMARK_MAIN();
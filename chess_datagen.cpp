@@ -0,0 +1,199 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "Search.h"
+#include "PositionFile.h"
+
+// Self-play training data: each worker plays its own games and writes every searched
+// position with the search score and the final result to its own shard, <out>.<n>.bin.
+// Usage: chess_datagen [--games n] [--threads n] [--depth n] [--nodes n]
+//                      [--random-plies n] [--out prefix] [--zlib] [--seed n]
+
+struct DatagenOptions
+{
+    int games = 100;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int depth = 0;           // 0: three plies, or as deep as the node budget allows
+    long long nodes = 0;     // Per-move node budget, 0 for none
+    int randomPlies = 8;     // Random moves opening each game, so games differ
+    int maxPlies = 300;      // Longer games are scored as draws
+    std::string out = "datagen";
+    bool zlib = false;
+    unsigned seed = 1;
+};
+
+class SeenPositions
+{
+    // Positions already written by any thread. Lockless: a slot is claimed with a
+    // compare-and-swap, and a position whose probe window is full is written again.
+private:
+    std::vector<std::atomic<unsigned long long>> slots;
+    size_t mask;
+
+public:
+    explicit SeenPositions(size_t size) : slots(size), mask(size - 1) {}
+
+    bool insert(unsigned long long key)
+    {
+        // True the first time a key is seen
+        key |= 1;  // 0 marks an empty slot
+        for (size_t i = 0; i < 8; ++i)
+        {
+            std::atomic<unsigned long long> &slot = slots[(key + i) & mask];
+            unsigned long long current = slot.load(std::memory_order_relaxed);
+            if (current == key) return false;
+            if (current == 0 && slot.compare_exchange_strong(current, key, std::memory_order_relaxed)) return true;
+            if (current == key) return false;
+        }
+        return true;
+    }
+};
+
+struct DatagenCounters
+{
+    std::atomic<long long> games{0}, written{0}, duplicates{0}, unpackable{0}, nodes{0};
+};
+
+static void playGames(int id, const DatagenOptions &opt, std::atomic<int> &gamesLeft, SeenPositions &seen,
+                      DatagenCounters &counters)
+{
+    PositionWriter writer;
+    std::string path = opt.out + "." + std::to_string(id) + ".bin";
+    if (!writer.open(path, opt.zlib))
+    {
+        std::cerr << "Cannot write " << path << "\n";
+        return;
+    }
+
+    std::mt19937 rng(opt.seed * 7919 + id);
+    Search search;
+    search.nodeLimit = opt.nodes;
+    std::vector<PackedPosition> game;
+    std::vector<unsigned long long> history;
+
+    while (gamesLeft-- > 0)
+    {
+        Board board;
+        Color turn = WHITE;
+        int ply = 0, halfmoveClock = 0, result = 0;
+        game.clear();
+        history.clear();
+
+        // Random opening; start over if it stumbles into a finished game
+        for (; ply < opt.randomPlies; ++ply)
+        {
+            std::vector<Move> moves = legalMoves(board, turn);
+            if (moves.empty()) break;
+            Move m = moves[rng() % moves.size()];
+            board.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+            turn = (turn == WHITE ? BLACK : WHITE);
+        }
+        if (ply < opt.randomPlies)
+        {
+            ++gamesLeft;
+            continue;
+        }
+
+        for (; ply < opt.maxPlies && halfmoveClock < 100; ++ply)
+        {
+            PositionState state = board.positionState(turn);
+            if (state.result != IN_PROGRESS)
+            {
+                if (state.result == CHECKMATE) result = (turn == WHITE) ? -1 : 1;
+                break;
+            }
+
+            // A third repetition is a draw
+            unsigned long long key = board.hash(turn);
+            if (std::count(history.begin(), history.end(), key) >= 2) break;
+            history.push_back(key);
+
+            search.timer.startInfinite();
+            Move m = search.think(board, turn, opt.depth);
+            counters.nodes += search.nodes;
+
+            // Quiet positions only: a score taken in check or before a capture says little about the eval
+            if (!state.checkers && !board.isCapture(m) && m.promotion == ' ')
+            {
+                // Pack before marking the key seen, so a position pack() rejects is not counted as a duplicate
+                PackedPosition p;
+                if (!board.pack(p, turn, halfmoveClock, ply / 2 + 1)) ++counters.unpackable;
+                else if (!seen.insert(key)) ++counters.duplicates;
+                else
+                {
+                    p.score = (short)std::max(-32000, std::min(32000, search.bestScore));
+                    game.push_back(p);
+                }
+            }
+
+            const Board &view = board;
+            bool resetsClock = board.isCapture(m) || view.pieceAt(m.sx, m.sy).type == 'P';
+            board.movePiece(m.sx, m.sy, m.ex, m.ey, turn, m.promotion);
+            halfmoveClock = resetsClock ? 0 : halfmoveClock + 1;
+            turn = (turn == WHITE ? BLACK : WHITE);
+        }
+
+        // The result is only known once the game is over
+        for (PackedPosition &p : game)
+        {
+            p.result = (signed char)result;
+            writer.write(p);
+        }
+        counters.written += game.size();
+        ++counters.games;
+    }
+    writer.close();
+}
+
+int main(int argc, char *argv[])
+{
+    DatagenOptions opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--games" && hasValue) opt.games = atoi(argv[++i]);
+        else if (flag == "--threads" && hasValue) opt.threads = std::max(1, atoi(argv[++i]));
+        else if (flag == "--depth" && hasValue) opt.depth = atoi(argv[++i]);
+        else if (flag == "--nodes" && hasValue) opt.nodes = atoll(argv[++i]);
+        else if (flag == "--random-plies" && hasValue) opt.randomPlies = atoi(argv[++i]);
+        else if (flag == "--out" && hasValue) opt.out = argv[++i];
+        else if (flag == "--seed" && hasValue) opt.seed = atoi(argv[++i]);
+        else if (flag == "--zlib") opt.zlib = true;
+        else
+        {
+            std::cerr << "Usage: chess_datagen [--games n] [--threads n] [--depth n] [--nodes n]\n"
+                      << "                     [--random-plies n] [--out prefix] [--zlib] [--seed n]\n";
+            return 1;
+        }
+    }
+    if (opt.depth == 0) opt.depth = (opt.nodes > 0) ? MAX_PLY : 3;
+    if (opt.zlib && !positionCompressionAvailable())
+    {
+        std::cerr << "Built without zlib\n";
+        return 1;
+    }
+
+    SeenPositions seen(1 << 22);
+    DatagenCounters counters;
+    std::atomic<int> gamesLeft(opt.games);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < opt.threads; ++t)
+        pool.emplace_back(playGames, t, std::cref(opt), std::ref(gamesLeft), std::ref(seen), std::ref(counters));
+    for (std::thread &t : pool) t.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << counters.games << " games, " << counters.written << " positions, " << counters.duplicates
+              << " duplicates skipped, " << counters.unpackable << " unpackable skipped in " << seconds << " s\n"
+              << "Games/s: " << counters.games / seconds << "\n"
+              << "Positions/s: " << counters.written / seconds << "\n"
+              << "Nodes/s: " << (long long)(counters.nodes / seconds) << "\n";
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include "Search.h"
+#include "Notation.h"
+
+// Runs an EPD test suite: each position is searched under a fixed time or node budget
+// and counts as solved if the final move is a "bm" move, or avoids every "am" move.
+// Usage: chess_epd <file.epd> [--time ms] [--nodes n] [--depth n] [--threads n]
+
+struct EpdPosition
+{
+    std::string id, fen;
+    std::vector<std::string> best, avoid;  // Moves as written in the suite
+
+    // Filled in by the run
+    bool solved = false;
+    long long solvedAtMs = -1;  // When the search settled on a solving move for good
+    long long nodes = 0, elapsedMs = 0;
+    int depth = 0;
+    std::string played;
+};
+
+static bool parseEpd(const std::string &line, EpdPosition &out)
+{
+    // Four FEN fields, then "opcode operands;" operations
+    std::istringstream in(line);
+    std::string fields[4];
+    for (std::string &f : fields)
+        if (!(in >> f)) return false;
+    out.fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+
+    std::string rest, op;
+    std::getline(in, rest);
+    std::istringstream ops(rest);
+    while (std::getline(ops, op, ';'))
+    {
+        std::istringstream words(op);
+        std::string opcode, operand;
+        if (!(words >> opcode)) continue;
+        if (opcode == "id")
+        {
+            std::getline(words >> std::ws, operand);
+            if (operand.size() >= 2 && operand.front() == '"') operand = operand.substr(1, operand.size() - 2);
+            out.id = operand;
+        }
+        else if (opcode == "bm" || opcode == "am")
+        {
+            while (words >> operand) (opcode == "bm" ? out.best : out.avoid).push_back(operand);
+        }
+    }
+    return !out.best.empty() || !out.avoid.empty();
+}
+
+struct EpdBudget
+{
+    long long timeMs = 1000;
+    long long nodes = 0;  // When set, replaces the time budget
+    int depth = MAX_PLY;
+};
+
+static void solve(EpdPosition &pos, const EpdBudget &budget)
+{
+    Board board;
+    Color turn;
+    if (!board.loadFen(pos.fen, turn)) return;
+
+    // Resolve the suite's moves once, so every iteration compares plain squares
+    std::vector<Move> best, avoid;
+    for (int list = 0; list < 2; ++list)
+    {
+        for (std::string &text : (list == 0 ? pos.best : pos.avoid))
+        {
+            Move m = parseMove(board, text, turn);
+            if (m.sx >= 0) (list == 0 ? best : avoid).push_back(m);
+            else std::cerr << pos.id << ": " << text << " is not a legal move here\n";
+        }
+    }
+    auto solves = [&](const Move &m) {
+        auto same = [&m](const Move &x) { return SearchTables::sameMove(x, m); };
+        if (!pos.best.empty()) return std::any_of(best.begin(), best.end(), same);
+        return std::none_of(avoid.begin(), avoid.end(), same);
+    };
+
+    Search search;
+    search.nodeLimit = budget.nodes;
+    search.onIteration = [&](Search &s) {
+        if (!solves(s.bestMove)) pos.solvedAtMs = -1;
+        else if (pos.solvedAtMs < 0) pos.solvedAtMs = s.timer.elapsed();
+    };
+    if (budget.nodes > 0) search.timer.startInfinite();
+    else search.timer.startFixed(budget.timeMs);
+    Move m = search.think(board, turn, budget.depth);
+
+    pos.elapsedMs = search.timer.elapsed();
+    pos.nodes = search.nodes;
+    pos.depth = search.completedDepth;
+    pos.solved = m.sx >= 0 && solves(m);
+    if (!pos.solved) pos.solvedAtMs = -1;
+    pos.played = (m.sx >= 0) ? toSan(board, m, turn) : "-";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: chess_epd <file.epd> [--time ms] [--nodes n] [--depth n] [--threads n]\n";
+        return 1;
+    }
+
+    EpdBudget budget;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        if (flag == "--time") budget.timeMs = atoll(argv[i + 1]);
+        else if (flag == "--nodes") budget.nodes = atoll(argv[i + 1]);
+        else if (flag == "--depth") budget.depth = std::max(1, std::min(atoi(argv[i + 1]), MAX_PLY));
+        else if (flag == "--threads") threads = std::max(1, atoi(argv[i + 1]));
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file)
+    {
+        std::cerr << "Cannot read " << argv[1] << "\n";
+        return 1;
+    }
+    std::vector<EpdPosition> suite;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        EpdPosition pos;
+        if (!parseEpd(line, pos)) continue;
+        if (pos.id.empty()) pos.id = "#" + std::to_string(suite.size() + 1);
+        suite.push_back(pos);
+    }
+
+    // Positions are handed out one at a time; each thread has its own Search
+    std::atomic<size_t> next(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < std::min(threads, (int)suite.size()); ++t)
+        pool.emplace_back([&]() {
+            for (size_t i = next++; i < suite.size(); i = next++) solve(suite[i], budget);
+        });
+    for (std::thread &t : pool) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int solved = 0;
+    long long nodes = 0, solveTimeMs = 0;
+    for (EpdPosition &pos : suite)
+    {
+        std::cout << (pos.solved ? "ok   " : "FAIL ") << pos.id << ": played " << pos.played << ", wanted "
+                  << (pos.best.empty() ? "not " : "");
+        for (std::string &m : (pos.best.empty() ? pos.avoid : pos.best)) std::cout << m << " ";
+        std::cout << "(depth " << pos.depth << ", " << pos.nodes << " nodes, " << pos.elapsedMs << " ms";
+        if (pos.solved) std::cout << ", solved at " << pos.solvedAtMs << " ms";
+        std::cout << ")\n";
+
+        nodes += pos.nodes;
+        if (pos.solved)
+        {
+            ++solved;
+            solveTimeMs += pos.solvedAtMs;
+        }
+    }
+
+    std::cout << "\nSolved: " << solved << "/" << suite.size() << " ("
+              << (suite.empty() ? 0 : 100.0 * solved / suite.size()) << "%)\n"
+              << "Mean time to solution: " << (solved ? solveTimeMs / solved : 0) << " ms\n"
+              << "Nodes: " << nodes << " in " << seconds << " s, " << threads << " threads\n"
+              << "Nodes/s: " << (long long)(nodes / std::max(seconds, 1e-9)) << "\n";
+    return 0;
+}
@@ -0,0 +1,375 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "Board.h"
+
+// Fuzz target for the move rules. The input picks a start position, then each byte picks
+// one legal move. After every move the board must hold one king per side and the mover
+// must not be in check. legalMoves must match a separate reference generator that shares
+// no code with Board's move rules, and makeMove tried on every square pair must accept
+// the same moves. Unmaking must restore the position bit for bit. Ends in mate or
+// stalemate must agree with isCheckmate and isStalemate. A broken invariant aborts;
+// nothing is printed, so libFuzzer and AFL run it at full speed.
+//
+// Built with -DCHESS_LIBFUZZER and -fsanitize=fuzzer it is a libFuzzer target. Otherwise
+// main runs each file named on the command line (AFL, crash replay), stdin with "-",
+// or a fixed number of pseudo-random inputs: chess_fuzz [--runs n] [--seed n] [files...]
+
+static const char *const START_FENS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+static const int START_FEN_COUNT = sizeof(START_FENS) / sizeof(START_FENS[0]);
+
+static void require(bool ok)
+{
+    if (!ok) abort();
+}
+
+static bool samePosition(Board &a, Board &b)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        for (int j = 0; j < 8; ++j)
+        {
+            const Piece &p = a.pieceAt(i, j), &q = b.pieceAt(i, j);
+            if (p.type != q.type || p.color != q.color || p.hasMoved != q.hasMoved) return false;
+        }
+    }
+    return a.hash(WHITE) == b.hash(WHITE);  // Also covers the en passant square
+}
+
+static bool moveLess(const Move &a, const Move &b)
+{
+    if (a.sx != b.sx) return a.sx < b.sx;
+    if (a.sy != b.sy) return a.sy < b.sy;
+    if (a.ex != b.ex) return a.ex < b.ex;
+    if (a.ey != b.ey) return a.ey < b.ey;
+    return a.promotion < b.promotion;
+}
+
+struct ReferencePosition
+{
+    // The board as FEN letters, '.' for empty, square row * 8 + col with row 0 on rank 8
+    char squares[64];
+    bool unmoved[64];
+    int enPassant = -1;
+    bool chess960 = false;
+};
+
+static ReferencePosition referenceOf(Board &board, Color turn)
+{
+    ReferencePosition pos;
+    const Board &view = board;
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        const Piece &p = view.pieceAt(sq / 8, sq % 8);
+        pos.squares[sq] = (p.type == ' ') ? '.' : (p.color == WHITE ? p.type : char(tolower(p.type)));
+        pos.unmoved[sq] = !p.hasMoved;
+    }
+    // The en passant square comes from the FEN, which only names one the side to move can use
+    std::string fen = board.toFen(turn);
+    size_t field = fen.find(' ', fen.find(' ', fen.find(' ') + 1) + 1) + 1;
+    if (fen[field] != '-') pos.enPassant = (8 - (fen[field + 1] - '0')) * 8 + (fen[field] - 'a');
+    pos.chess960 = board.chess960;
+    return pos;
+}
+
+static bool ownedBy(char code, bool white)
+{
+    return code != '.' && (isupper(code) != 0) == white;
+}
+
+static bool referenceAttacked(const char *squares, int sq, bool byWhite)
+{
+    // Looks outward from sq for each kind of attacker
+    static const int knight[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+    static const int king[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    int row = sq / 8, col = sq % 8;
+    auto at = [&](int r, int c) { return (r < 0 || r > 7 || c < 0 || c > 7) ? '\0' : squares[r * 8 + c]; };
+    auto is = [&](char code, char type) { return code && ownedBy(code, byWhite) && toupper(code) == type; };
+
+    int pawnRow = byWhite ? row + 1 : row - 1;  // White pawns attack toward row 0
+    if (is(at(pawnRow, col - 1), 'P') || is(at(pawnRow, col + 1), 'P')) return true;
+    for (int k = 0; k < 8; ++k)
+    {
+        if (is(at(row + knight[k][0], col + knight[k][1]), 'N')) return true;
+        if (is(at(row + king[k][0], col + king[k][1]), 'K')) return true;
+
+        char slider = (king[k][0] != 0 && king[k][1] != 0) ? 'B' : 'R';
+        for (int r = row + king[k][0], c = col + king[k][1]; at(r, c); r += king[k][0], c += king[k][1])
+        {
+            char code = at(r, c);
+            if (code == '.') continue;
+            if (is(code, slider) || is(code, 'Q')) return true;
+            break;
+        }
+    }
+    return false;
+}
+
+static bool referenceKingSafe(const char *squares, bool white)
+{
+    for (int sq = 0; sq < 64; ++sq)
+        if (squares[sq] == (white ? 'K' : 'k')) return !referenceAttacked(squares, sq, !white);
+    return true;
+}
+
+static std::vector<Move> referenceMoves(const ReferencePosition &pos, Color turn)
+{
+    // Independent legal move generator on a plain square array: pseudo-legal moves, each
+    // kept if the mover's king is not attacked afterwards
+    static const int knight[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+    static const int king[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    static const char promotions[4] = {'Q', 'R', 'B', 'N'};
+    bool white = turn == WHITE;
+    std::vector<Move> moves;
+
+    auto tryMove = [&](int from, int to, char promotion, int captured)
+    {
+        char after[64];
+        memcpy(after, pos.squares, 64);
+        after[to] = promotion == ' ' ? after[from] : (white ? promotion : char(tolower(promotion)));
+        after[from] = '.';
+        if (captured >= 0 && captured != to) after[captured] = '.';
+        if (referenceKingSafe(after, white)) moves.push_back(Move(from / 8, from % 8, to / 8, to % 8, promotion));
+    };
+
+    for (int from = 0; from < 64; ++from)
+    {
+        char code = pos.squares[from];
+        if (!ownedBy(code, white)) continue;
+        int row = from / 8, col = from % 8;
+        char type = char(toupper(code));
+
+        if (type == 'P')
+        {
+            int dir = white ? -1 : 1, next = row + dir;
+            bool last = next == 0 || next == 7;
+            for (int dc = -1; dc <= 1; ++dc)
+            {
+                int c = col + dc;
+                if (c < 0 || c > 7) continue;
+                int to = next * 8 + c;
+                bool enPassant = dc != 0 && to == pos.enPassant;
+                if (dc == 0 ? pos.squares[to] != '.' : !(ownedBy(pos.squares[to], !white) || enPassant)) continue;
+                int captured = enPassant ? row * 8 + c : to;
+                if (last)
+                    for (char p : promotions) tryMove(from, to, p, captured);
+                else tryMove(from, to, ' ', captured);
+            }
+            int start = white ? 6 : 1;
+            if (row == start && pos.squares[next * 8 + col] == '.' && pos.squares[(row + 2 * dir) * 8 + col] == '.')
+                tryMove(from, (row + 2 * dir) * 8 + col, ' ', -1);
+        }
+        else if (type == 'N' || type == 'K')
+        {
+            const int (*steps)[2] = (type == 'N') ? knight : king;
+            for (int k = 0; k < 8; ++k)
+            {
+                int r = row + steps[k][0], c = col + steps[k][1];
+                if (r < 0 || r > 7 || c < 0 || c > 7 || ownedBy(pos.squares[r * 8 + c], white)) continue;
+                tryMove(from, r * 8 + c, ' ', r * 8 + c);
+            }
+        }
+        else
+        {
+            for (int k = 0; k < 8; ++k)
+            {
+                bool diagonal = king[k][0] != 0 && king[k][1] != 0;
+                if ((type == 'R' && diagonal) || (type == 'B' && !diagonal)) continue;
+                for (int r = row + king[k][0], c = col + king[k][1]; r >= 0 && r <= 7 && c >= 0 && c <= 7;
+                     r += king[k][0], c += king[k][1])
+                {
+                    if (ownedBy(pos.squares[r * 8 + c], white)) break;
+                    tryMove(from, r * 8 + c, ' ', r * 8 + c);
+                    if (pos.squares[r * 8 + c] != '.') break;
+                }
+            }
+        }
+
+        // Castling with an unmoved king and rook on the home rank: both end on the usual files,
+        // nothing else may stand on the squares they use, and the king's path is not attacked
+        int home = white ? 7 : 0;
+        if (type != 'K' || row != home || !pos.unmoved[from]) continue;
+        for (int rookCol = 0; rookCol < 8; ++rookCol)
+        {
+            int rook = home * 8 + rookCol;
+            if (pos.squares[rook] != (white ? 'R' : 'r') || !pos.unmoved[rook]) continue;
+            if (!pos.chess960 && (col != 4 || (rookCol != 0 && rookCol != 7))) continue;
+            bool kingSide = rookCol > col;
+            int kingTo = kingSide ? 6 : 2, rookTo = kingSide ? 5 : 3;
+            bool ok = true;
+            for (int c = std::min({col, rookCol, kingTo, rookTo}); c <= std::max({col, rookCol, kingTo, rookTo}); ++c)
+                if (c != col && c != rookCol && pos.squares[home * 8 + c] != '.') ok = false;
+            for (int c = std::min(col, kingTo); c <= std::max(col, kingTo); ++c)
+                if (referenceAttacked(pos.squares, home * 8 + c, !white)) ok = false;
+            if (!ok) continue;
+
+            char after[64];
+            memcpy(after, pos.squares, 64);
+            after[from] = after[rook] = '.';
+            after[home * 8 + kingTo] = white ? 'K' : 'k';
+            after[home * 8 + rookTo] = white ? 'R' : 'r';
+            if (!referenceKingSafe(after, white)) continue;
+            moves.push_back(Move(home, col, home, pos.chess960 ? rookCol : kingTo));
+        }
+    }
+    return moves;
+}
+
+static std::vector<Move> refereeMoves(Board &board, Color turn)
+{
+    // Every from/to pair offered to makeMove on the board itself.
+    // Each accepted move is undone at once; refused ones must leave nothing behind either,
+    // which the comparison after each accepted move and at the end would catch.
+    static const char promotions[4] = {'Q', 'R', 'B', 'N'};
+    std::vector<Move> moves;
+    BoardArena arena;
+    Board before = board;
+    for (int sq = 0; sq < 64; ++sq)
+    {
+        const Piece &p = board.pieceAt(sq / 8, sq % 8);
+        if (p.color != turn) continue;
+        bool pawn = p.type == 'P';
+        for (int to = 0; to < 64; ++to)
+        {
+            bool promoting = pawn && (to / 8 == 0 || to / 8 == 7);
+            for (int k = 0; k < (promoting ? 4 : 1); ++k)
+            {
+                Move m(sq / 8, sq % 8, to / 8, to % 8, promoting ? promotions[k] : ' ');
+                UndoRecord undo;
+                if (!board.makeMove(m, turn, undo)) continue;
+                moves.push_back(m);
+                board.unmakeMove(undo);
+                require(samePosition(board, before));
+            }
+        }
+    }
+    require(samePosition(board, before));
+    return moves;
+}
+
+static std::vector<Move> checkPosition(Board &board, Color turn)
+{
+    // Returns the legal moves in a fixed order
+    int kings[2] = {0, 0};
+    for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 8; ++j)
+            if (board.pieceAt(i, j).type == 'K') ++kings[board.pieceAt(i, j).color == WHITE ? 0 : 1];
+    require(kings[0] == 1 && kings[1] == 1);
+
+    // The side that just moved never leaves its king attacked
+    require(!board.isCheck(turn == WHITE ? BLACK : WHITE));
+
+    std::vector<Move> legal = legalMoves(board, turn);
+    std::sort(legal.begin(), legal.end(), moveLess);
+    std::vector<Move> lists[2] = {referenceMoves(referenceOf(board, turn), turn), refereeMoves(board, turn)};
+    for (std::vector<Move> &other : lists)
+    {
+        std::sort(other.begin(), other.end(), moveLess);
+        require(legal.size() == other.size());
+        for (size_t k = 0; k < legal.size(); ++k) require(!moveLess(legal[k], other[k]) && !moveLess(other[k], legal[k]));
+    }
+
+    bool check = board.isCheck(turn);
+    require(board.isCheckmate(turn) == (legal.empty() && check));
+    require(board.isStalemate(turn) == (legal.empty() && !check));
+    return legal;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (size < 3) return 0;
+
+    // Byte 0 picks a test FEN or a Chess960 setup, bytes 1-2 the Chess960 number
+    Board board;
+    Color turn = WHITE;
+    if (data[0] % 8 < START_FEN_COUNT) require(board.loadFen(START_FENS[data[0] % 8], turn));
+    else board.setupChess960((data[1] | data[2] << 8) % 960);
+
+    for (size_t i = 3; i < size; ++i)
+    {
+        std::vector<Move> legal = checkPosition(board, turn);
+        if (legal.empty()) break;
+
+        UndoRecord undo;
+        unsigned long long key = board.hash(turn);
+        require(board.makeMove(legal[data[i] % legal.size()], turn, undo));
+        turn = (turn == WHITE ? BLACK : WHITE);
+
+        // Every other move is taken back and replayed, so unmaking is exercised mid-game too
+        if (i % 2 == 0)
+        {
+            Color mover = (turn == WHITE ? BLACK : WHITE);
+            Move played = undo.move;
+            board.unmakeMove(undo);
+            require(board.hash(mover) == key);
+            require(board.makeMove(played, mover, undo));
+        }
+    }
+    return 0;
+}
+
+#ifndef CHESS_LIBFUZZER
+static bool readInput(FILE *file, std::vector<uint8_t> &data)
+{
+    data.clear();
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) data.insert(data.end(), buffer, buffer + n);
+    return !ferror(file);
+}
+
+int main(int argc, char *argv[])
+{
+    long long runs = 1000;
+    unsigned long long seed = 1;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) runs = atoll(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else files.push_back(arg);
+    }
+
+    std::vector<uint8_t> data;
+    if (!files.empty())
+    {
+        for (std::string &name : files)
+        {
+            FILE *file = (name == "-") ? stdin : fopen(name.c_str(), "rb");
+            if (!file || !readInput(file, data))
+            {
+                fprintf(stderr, "Cannot read %s\n", name.c_str());
+                return 1;
+            }
+            if (file != stdin) fclose(file);
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        return 0;
+    }
+
+    // Deterministic smoke run: the same inputs for the same seed, games of up to 200 plies
+    for (long long run = 0; run < runs; ++run)
+    {
+        data.resize(3 + (seed >> 33) % 200);
+        for (uint8_t &byte : data)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            byte = uint8_t(seed >> 56);
+        }
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    printf("%lld inputs, all invariants held\n", runs);
+    return 0;
+}
+#endif
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+// Load generator for chess_server: each connection opens its games, then plays
+// knight moves back and forth in all of them, one request in flight at a time.
+// Usage: chess_loadgen [port] [connections] [games per connection] [moves per game]
+
+static const char *shuffle[4] = {"G1F3", "G8F6", "F3G1", "F6G8"};
+
+class LineClient
+{
+private:
+    int fd;
+    std::string buffer;
+
+public:
+    LineClient(int port)
+    {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0) fd = -1;
+    }
+
+    ~LineClient()
+    {
+        if (fd >= 0) close(fd);
+    }
+
+    bool connected()
+    {
+        return fd >= 0;
+    }
+
+    std::string request(const std::string &line)
+    {
+        std::string out = line + "\n";
+        if (write(fd, out.data(), out.size()) < 0) return "";
+        size_t end;
+        while ((end = buffer.find('\n')) == std::string::npos)
+        {
+            char chunk[4096];
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n <= 0) return "";
+            buffer.append(chunk, n);
+        }
+        std::string reply = buffer.substr(0, end);
+        buffer.erase(0, end + 1);
+        return reply;
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    int port = (argc > 1) ? std::atoi(argv[1]) : 5555;
+    int connections = (argc > 2) ? std::atoi(argv[2]) : 8;
+    int gamesPerConnection = (argc > 3) ? std::atoi(argv[3]) : 1000;
+    int movesPerGame = (argc > 4) ? std::atoi(argv[4]) : 8;
+
+    std::vector<std::vector<double>> latencies(connections);
+    std::vector<int> errors(connections, 0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < connections; ++c)
+    {
+        threads.emplace_back([&, c]() {
+            LineClient client(port);
+            if (!client.connected())
+            {
+                ++errors[c];
+                return;
+            }
+
+            std::vector<int> games;
+            for (int g = 0; g < gamesPerConnection; ++g)
+            {
+                std::string reply = client.request("NEW");
+                if (reply.find(" NEW") == std::string::npos) ++errors[c];
+                else games.push_back(std::atoi(reply.c_str()));
+            }
+
+            for (int m = 0; m < movesPerGame; ++m)
+            {
+                for (int id : games)
+                {
+                    auto sent = std::chrono::steady_clock::now();
+                    std::string reply = client.request("MOVE " + std::to_string(id) + " " + shuffle[m % 4]);
+                    latencies[c].push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+                    if (reply.find(" OK ") == std::string::npos) ++errors[c];
+                }
+            }
+
+            // Report memory with every game still open, then clean up
+            if (c == 0) std::cout << client.request("STATS") << "\n";
+            for (int id : games) client.request("END " + std::to_string(id));
+        });
+    }
+    for (std::thread &t : threads) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    int errorCount = 0;
+    for (int c = 0; c < connections; ++c)
+    {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        errorCount += errors[c];
+    }
+    std::sort(all.begin(), all.end());
+    if (all.empty())
+    {
+        std::cout << "No moves completed, " << errorCount << " errors\n";
+        return 1;
+    }
+
+    std::cout << "games " << (long long)connections * gamesPerConnection << ", moves " << all.size()
+              << ", errors " << errorCount << ", " << (long long)(all.size() / seconds) << " moves/s\n";
+    std::cout << "latency us: p50 " << all[all.size() / 2] << ", p99 " << all[all.size() * 99 / 100]
+              << ", max " << all.back() << "\n";
+    return errorCount ? 1 : 0;
+}
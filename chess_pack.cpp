@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <sys/stat.h>
+#include "PositionFile.h"
+
+// Converts FEN lines to a packed position file and back.
+// Usage: chess_pack write <file> [--zlib] < fens
+//        chess_pack read <file> > fens
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    std::string mode = (argc > 2) ? argv[1] : "", path = (argc > 2) ? argv[2] : "";
+    bool zlib = argc > 3 && std::string(argv[3]) == "--zlib";
+    std::ios::sync_with_stdio(false);
+
+    if (mode == "write")
+    {
+        PositionWriter writer;
+        if (!writer.open(path, zlib))
+        {
+            std::cerr << "Cannot write " << path << (zlib && !positionCompressionAvailable() ? " (built without zlib)" : "") << "\n";
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::string line;
+        unsigned long long skipped = 0, fenBytes = 0;
+        Board board;
+        Color turn;
+        while (std::getline(std::cin, line))
+        {
+            // Keep the clocks, which Board itself drops
+            std::istringstream fields(line);
+            std::string skip;
+            int halfmove = 0, fullmove = 1;
+            fields >> skip >> skip >> skip >> skip >> halfmove >> fullmove;
+
+            // Unreadable FENs and boards with more than 32 pieces are skipped
+            PackedPosition packed;
+            if (!board.loadFen(line, turn) || !board.pack(packed, turn, halfmove, fullmove))
+            {
+                ++skipped;
+                continue;
+            }
+            writer.write(packed);
+            fenBytes += line.size() + 1;
+        }
+        unsigned long long count = writer.count();
+        if (!writer.close())
+        {
+            std::cerr << "Write to " << path << " failed\n";
+            return 1;
+        }
+        struct stat st;
+        stat(path.c_str(), &st);
+        std::cerr << count << " positions (" << skipped << " skipped) in " << secondsSince(start) << " s, "
+                  << st.st_size << " bytes vs " << fenBytes << " as FEN, "
+                  << (count ? (double)st.st_size / count : 0) << " bytes/position\n";
+        return 0;
+    }
+
+    if (mode == "read")
+    {
+        PositionReader reader;
+        if (!reader.open(path))
+        {
+            std::cerr << "Cannot read " << path << "\n";
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        PackedPosition p;
+        Board board;
+        Color turn;
+        unsigned long long count = 0;
+        while (reader.next(p))
+        {
+            if (!board.unpack(p, turn)) continue;
+            std::string fen = board.toFen(turn);
+            fen.resize(fen.size() - 3);  // Swap the default clocks for the stored ones
+            std::cout << fen << (int)p.halfmoveClock << " " << p.fullmoveNumber << "\n";
+            ++count;
+        }
+        std::cerr << count << " positions in " << secondsSince(start) << " s\n";
+        return 0;
+    }
+
+    std::cerr << "Usage: chess_pack write <file> [--zlib] < fens\n"
+              << "       chess_pack read <file> > fens\n";
+    return 1;
+}
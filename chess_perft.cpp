@@ -0,0 +1,56 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include "Perft.h"
+
+// Counts legal move paths from a position, split by root move.
+// Usage: chess_perft <depth> [--threads N] [--hash MB] [--fen "<fen>"]
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: chess_perft <depth> [--threads N] [--hash MB] [--fen \"<fen>\"]\n";
+        return 1;
+    }
+
+    int depth = atoi(argv[1]);
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t hashMb = 64;
+    std::string fen;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        if (flag == "--threads") threads = atoi(argv[i + 1]);
+        else if (flag == "--hash") hashMb = atoi(argv[i + 1]);
+        else if (flag == "--fen") fen = argv[i + 1];
+    }
+
+    Board board;
+    Color turn = WHITE;
+    if (!fen.empty() && !board.loadFen(fen, turn))
+    {
+        std::cerr << "Bad FEN: " << fen << "\n";
+        return 1;
+    }
+
+    PerftTable table(hashMb);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<PerftDivide> divide = perftDivide(board, turn, depth, threads, &table);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned long long total = 0;
+    for (PerftDivide &d : divide)
+    {
+        Move &m = d.move;
+        std::cout << char('a' + m.sy) << char('0' + 8 - m.sx) << char('a' + m.ey) << char('0' + 8 - m.ex);
+        if (m.promotion != ' ') std::cout << char(tolower(m.promotion));
+        std::cout << ": " << d.nodes << "\n";
+        total += d.nodes;
+    }
+    std::cout << "\nNodes: " << total << "\n"
+              << "Time: " << seconds << " s, " << threads << " threads, " << hashMb << " MB hash\n"
+              << "Nodes/s: " << (seconds > 0 ? (unsigned long long)(total / seconds) : 0) << "\n";
+    return 0;
+}
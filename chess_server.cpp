@@ -0,0 +1,566 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Board.h"
+#include "Spectator.h"
+
+// Hosts many games in one process. Clients send one command per line:
+//   NEW                 -> "<id> NEW"
+//   MOVE <id> E2E4[Q]   -> "<id> OK IN_PROGRESS|CHECKMATE|STALEMATE", "<id> ILLEGAL" or "<id> OVER"
+//   END <id>            -> "<id> END"
+//   STATS               -> "STATS games=<n> rss_kb=<kb>"
+//   WATCH <id> [ANSI]   -> "<id> BOARD <64 square codes>", then "<id> DELTA e4P e2." after each move;
+//                          with ANSI, a terminal frame and then only cursor updates for changed squares
+//   QUIT
+// Errors come back as "ERR <reason>". Replies for different games may arrive out of order,
+// which is why each one starts with the game id.
+//
+// One epoll thread owns the sockets and the id free list. Every game belongs to worker
+// (id % workers), so a game's commands run in order on one thread and games need no locks.
+
+struct Game
+{
+    Board board;
+    Color turn = WHITE;
+    SquareCodes shown;  // The position spectators have last been sent
+
+    Game()
+    {
+        board.squareCodes(shown.codes);
+    }
+};
+
+struct Task
+{
+    enum Kind { NEW, MOVE, END, WATCH } kind;
+    int fd;
+    unsigned long long connection;
+    int game;
+    std::string move;
+};
+
+struct Completion
+{
+    int fd;
+    unsigned long long connection;
+    std::string reply;
+    int freedGame;  // Slot to return to the free list, or -1
+    int watching = -1;               // Game the connection starts spectating once this first frame is out, or -1
+    bool ansi = false;               // Style of that spectator's deltas
+    int spectated = -1;              // Game whose spectators get the squares below, or -1
+    unsigned long long changed = 0;  // Squares a move changed
+    SquareCodes codes = {};          // New codes of the changed squares
+};
+
+class CompletionQueue
+{
+    // Workers hand replies back to the event loop and wake it through an eventfd
+private:
+    std::mutex lock;
+    std::vector<Completion> items;
+
+public:
+    int eventFd = eventfd(0, EFD_NONBLOCK);
+
+    void push(Completion c)
+    {
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            wasEmpty = items.empty();
+            items.push_back(std::move(c));
+        }
+        if (wasEmpty)
+        {
+            unsigned long long one = 1;
+            if (write(eventFd, &one, sizeof(one)) < 0) {}
+        }
+    }
+
+    std::vector<Completion> drain()
+    {
+        unsigned long long count;
+        if (read(eventFd, &count, sizeof(count)) < 0) {}
+        std::lock_guard<std::mutex> guard(lock);
+        std::vector<Completion> out;
+        out.swap(items);
+        return out;
+    }
+};
+
+class Worker
+{
+private:
+    std::vector<std::unique_ptr<Game>> &games;
+    CompletionQueue &completions;
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque<Task> tasks;
+    bool stopping = false;
+    std::thread thread;
+
+    void run()
+    {
+        while (true)
+        {
+            std::deque<Task> batch;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                ready.wait(guard, [this]() { return stopping || !tasks.empty(); });
+                if (stopping && tasks.empty()) return;
+                batch.swap(tasks);
+            }
+            for (Task &t : batch) handle(t);
+        }
+    }
+
+    void handle(Task &t)
+    {
+        std::string id = std::to_string(t.game);
+        std::unique_ptr<Game> &slot = games[t.game];
+
+        if (t.kind == Task::NEW)
+        {
+            // Freed slots keep their allocation and are reset in place
+            if (slot) *slot = Game();
+            else slot.reset(new Game());
+            completions.push({t.fd, t.connection, id + " NEW\n", -1});
+        }
+        else if (t.kind == Task::END)
+        {
+            completions.push({t.fd, t.connection, id + " END\n", t.game});
+        }
+        else if (t.kind == Task::WATCH)
+        {
+            // The first frame is the whole board; the event loop registers the spectator when it
+            // delivers this, so every delta it gets comes after the frame
+            char frame[SPECTATOR_FRAME_SIZE];
+            Completion c = {t.fd, t.connection, "", -1};
+            c.watching = t.game;
+            c.ansi = t.move == "ANSI";
+            if (c.ansi) c.reply.assign(frame, ansiFrame(slot->shown, frame));
+            else c.reply = id + " BOARD " + std::string(slot->shown.codes, 64) + "\n";
+            completions.push(c);
+        }
+        else
+        {
+            Completion c = {t.fd, t.connection, id + " " + playMove(*slot, t.move) + "\n", -1};
+            SquareCodes now;
+            slot->board.squareCodes(now.codes);
+            c.changed = changedSquares(slot->shown, now);
+            if (c.changed)
+            {
+                c.spectated = t.game;
+                c.codes = now;
+                slot->shown = now;
+            }
+            completions.push(c);
+        }
+    }
+
+    std::string playMove(Game &game, const std::string &m)
+    {
+        if (m.size() < 4 || m.size() > 5) return "ILLEGAL";
+        int sy = toupper(m[0]) - 'A', sx = 8 - (m[1] - '0');
+        int ey = toupper(m[2]) - 'A', ex = 8 - (m[3] - '0');
+        if (!game.board.isInsideBoard(sx, sy) || !game.board.isInsideBoard(ex, ey)) return "ILLEGAL";
+        char promotion = (m.size() == 5) ? toupper(m[4]) : 'Q';  // Never fall back to the stdin prompt
+
+        if (game.board.positionState(game.turn).result != IN_PROGRESS) return "OVER";
+        if (!game.board.movePiece(sx, sy, ex, ey, game.turn, promotion)) return "ILLEGAL";
+        game.turn = (game.turn == WHITE ? BLACK : WHITE);
+
+        static const char *results[] = {"IN_PROGRESS", "CHECKMATE", "STALEMATE"};
+        return std::string("OK ") + results[game.board.positionState(game.turn).result];
+    }
+
+public:
+    Worker(std::vector<std::unique_ptr<Game>> &g, CompletionQueue &c) : games(g), completions(c)
+    {
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~Worker()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_one();
+        thread.join();
+    }
+
+    void post(Task t)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push_back(std::move(t));
+        }
+        ready.notify_one();
+    }
+};
+
+struct Spectator
+{
+    int fd;
+    unsigned long long connection;
+    bool ansi;
+};
+
+struct Connection
+{
+    unsigned long long serial;
+    std::string in;
+    std::string out;
+    bool waitingToWrite;  // EPOLLOUT is armed
+};
+
+class GameServer
+{
+private:
+    int epollFd = epoll_create1(0);
+    std::vector<int> listeners;
+    CompletionQueue completions;
+    std::vector<std::unique_ptr<Game>> games;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<char> inUse;
+    std::vector<int> freeSlots;
+    int nextSlot = 0;
+    int activeGames = 0;
+    std::unordered_map<int, Connection> connections;
+    std::unordered_map<int, std::vector<Spectator>> spectators;  // By game id
+    unsigned long long nextSerial = 1;
+
+    static void setNonBlocking(int fd)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    void watch(int fd, unsigned int events, int op)
+    {
+        epoll_event ev = {};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(epollFd, op, fd, &ev);
+    }
+
+    void send(int fd, const std::string &text)
+    {
+        Connection &c = connections[fd];
+        bool idle = c.out.empty();
+        c.out += text;
+        if (idle) flush(fd);
+    }
+
+    void flush(int fd)
+    {
+        Connection &c = connections[fd];
+        while (!c.out.empty())
+        {
+            ssize_t n = write(fd, c.out.data(), c.out.size());
+            if (n <= 0) break;
+            c.out.erase(0, n);
+        }
+        // Ask for EPOLLOUT only while output is backed up
+        if (c.waitingToWrite != !c.out.empty())
+        {
+            c.waitingToWrite = !c.out.empty();
+            watch(fd, c.waitingToWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN, EPOLL_CTL_MOD);
+        }
+    }
+
+    void close(int fd)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        connections.erase(fd);
+    }
+
+    void accept(int listener)
+    {
+        while (true)
+        {
+            int fd = ::accept(listener, nullptr, nullptr);
+            if (fd < 0) return;
+            setNonBlocking(fd);
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            connections[fd] = Connection{nextSerial++, "", "", false};
+            watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+        }
+    }
+
+    void receive(int fd)
+    {
+        char buffer[16384];
+        while (true)
+        {
+            ssize_t n = read(fd, buffer, sizeof(buffer));
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+            {
+                close(fd);
+                return;
+            }
+            if (n < 0) break;
+            connections[fd].in.append(buffer, n);
+        }
+
+        // Handle every complete line; keep a partial one for the next read
+        std::string &in = connections[fd].in;
+        size_t start = 0, end;
+        while ((end = in.find('\n', start)) != std::string::npos)
+        {
+            std::string line = in.substr(start, end - start);
+            start = end + 1;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!command(fd, line)) return;  // Connection closed
+        }
+        in.erase(0, start);
+    }
+
+    bool command(int fd, const std::string &line)
+    {
+        char verb[16] = {}, move[16] = {};
+        int id = -1;
+        int fields = sscanf(line.c_str(), "%15s %d %15s", verb, &id, move);
+        std::string v = verb;
+        unsigned long long serial = connections[fd].serial;
+
+        if (v == "NEW")
+        {
+            int slot;
+            if (!freeSlots.empty())
+            {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else if (nextSlot < (int)games.size()) slot = nextSlot++;
+            else
+            {
+                send(fd, "ERR full\n");
+                return true;
+            }
+            inUse[slot] = 1;
+            ++activeGames;
+            workers[slot % workers.size()]->post({Task::NEW, fd, serial, slot, ""});
+        }
+        else if ((v == "MOVE" && fields == 3) || (v == "END" && fields >= 2))
+        {
+            if (id < 0 || id >= (int)games.size() || !inUse[id])
+            {
+                send(fd, "ERR unknown game\n");
+                return true;
+            }
+            if (v == "END")
+            {
+                // Refuse further moves now; the slot is reused once the worker has seen the END
+                inUse[id] = 0;
+                --activeGames;
+                spectators.erase(id);
+                workers[id % workers.size()]->post({Task::END, fd, serial, id, ""});
+            }
+            else workers[id % workers.size()]->post({Task::MOVE, fd, serial, id, move});
+        }
+        else if (v == "WATCH" && fields >= 2)
+        {
+            if (id < 0 || id >= (int)games.size() || !inUse[id])
+            {
+                send(fd, "ERR unknown game\n");
+                return true;
+            }
+            bool ansi = fields == 3 && std::string(move) == "ANSI";
+            workers[id % workers.size()]->post({Task::WATCH, fd, serial, id, ansi ? "ANSI" : ""});
+        }
+        else if (v == "STATS")
+        {
+            long pages = 0, resident = 0;
+            FILE *statm = fopen("/proc/self/statm", "r");
+            if (statm)
+            {
+                if (fscanf(statm, "%ld %ld", &pages, &resident) != 2) resident = 0;
+                fclose(statm);
+            }
+            send(fd, "STATS games=" + std::to_string(activeGames) +
+                         " rss_kb=" + std::to_string(resident * (sysconf(_SC_PAGESIZE) / 1024)) + "\n");
+        }
+        else if (v == "QUIT")
+        {
+            close(fd);
+            return false;
+        }
+        else send(fd, "ERR bad command\n");
+        return true;
+    }
+
+    void deliver()
+    {
+        for (Completion &c : completions.drain())
+        {
+            if (c.freedGame >= 0) freeSlots.push_back(c.freedGame);
+
+            // The client may have gone, and its fd may already belong to someone else
+            auto it = connections.find(c.fd);
+            bool live = it != connections.end() && it->second.serial == c.connection;
+            if (live) send(c.fd, c.reply);
+            // Not registered if the game ended while its first frame was being made
+            if (live && c.watching >= 0 && inUse[c.watching]) spectators[c.watching].push_back({c.fd, c.connection, c.ansi});
+            if (c.spectated >= 0) spectate(c);
+        }
+    }
+
+    void spectate(const Completion &c)
+    {
+        // Each delta is formatted once per style and sent to every live spectator of the game
+        auto found = spectators.find(c.spectated);
+        if (found == spectators.end()) return;
+        char ansi[SPECTATOR_FRAME_SIZE], compact[SPECTATOR_FRAME_SIZE];
+        int ansiLength = -1, compactLength = -1;
+        std::vector<Spectator> &list = found->second;
+        for (size_t k = 0; k < list.size();)
+        {
+            auto it = connections.find(list[k].fd);
+            if (it == connections.end() || it->second.serial != list[k].connection)
+            {
+                list[k] = list.back();
+                list.pop_back();
+                continue;
+            }
+            if (list[k].ansi)
+            {
+                if (ansiLength < 0) ansiLength = ansiDelta(c.codes, c.changed, ansi);
+                send(list[k].fd, std::string(ansi, ansiLength));
+            } else
+            {
+                if (compactLength < 0)
+                {
+                    compactLength = sprintf(compact, "%d DELTA ", c.spectated);
+                    compactLength += compactDelta(c.codes, c.changed, compact + compactLength);
+                    compact[compactLength++] = '\n';
+                }
+                send(list[k].fd, std::string(compact, compactLength));
+            }
+            ++k;
+        }
+    }
+
+public:
+    GameServer(int maxGames, int workerCount) : games(maxGames), inUse(maxGames, 0)
+    {
+        for (int i = 0; i < workerCount; ++i) workers.emplace_back(new Worker(games, completions));
+        watch(completions.eventFd, EPOLLIN, EPOLL_CTL_ADD);
+    }
+
+    bool listenTcp(int port)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 1024) < 0) return false;
+        setNonBlocking(fd);
+        listeners.push_back(fd);
+        watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+        return true;
+    }
+
+    bool listenUnix(const std::string &path)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        unlink(path.c_str());
+        if (bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 1024) < 0) return false;
+        setNonBlocking(fd);
+        listeners.push_back(fd);
+        watch(fd, EPOLLIN, EPOLL_CTL_ADD);
+        return true;
+    }
+
+    void run()
+    {
+        epoll_event events[256];
+        while (true)
+        {
+            int n = epoll_wait(epollFd, events, 256, -1);
+            for (int i = 0; i < n; ++i)
+            {
+                int fd = events[i].data.fd;
+                bool listener = false;
+                for (int l : listeners) listener |= (l == fd);
+
+                if (listener) accept(fd);
+                else if (fd == completions.eventFd) deliver();
+                else
+                {
+                    if (events[i].events & (EPOLLHUP | EPOLLERR))
+                    {
+                        close(fd);
+                        continue;
+                    }
+                    if (events[i].events & EPOLLIN) receive(fd);
+                    if ((events[i].events & EPOLLOUT) && connections.count(fd)) flush(fd);
+                }
+            }
+        }
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    // chess_server [--port 5555] [--unix path] [--workers n] [--max-games n]
+    int port = 5555;
+    std::string unixPath;
+    int workerCount = std::max(1u, std::thread::hardware_concurrency());
+    int maxGames = 200000;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "--port") port = std::atoi(argv[i + 1]);
+        else if (arg == "--unix") unixPath = argv[i + 1];
+        else if (arg == "--workers") workerCount = std::max(1, std::atoi(argv[i + 1]));
+        else if (arg == "--max-games") maxGames = std::max(1, std::atoi(argv[i + 1]));
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    GameServer server(maxGames, workerCount);
+    if (!unixPath.empty())
+    {
+        if (!server.listenUnix(unixPath))
+        {
+            std::cerr << "Cannot listen on " << unixPath << "\n";
+            return 1;
+        }
+    }
+    else if (!server.listenTcp(port))
+    {
+        std::cerr << "Cannot listen on port " << port << "\n";
+        return 1;
+    }
+
+    std::cerr << "Serving up to " << maxGames << " games with " << workerCount << " workers\n";
+    server.run();
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string>
+#include "Pgn.h"
+
+// Reads PGN games with Chess960 starts, writes them back and reads the result again.
+// The castles must survive both trips. Exits non-zero if any game fails.
+
+static bool sameMoves(const GameRecord &a, const GameRecord &b)
+{
+    if (a.moves.size() != b.moves.size()) return false;
+    for (size_t i = 0; i < a.moves.size(); ++i)
+    {
+        const Move &x = a.moves[i], &y = b.moves[i];
+        if (x.sx != y.sx || x.sy != y.sy || x.ex != y.ex || x.ey != y.ey || x.promotion != y.promotion) return false;
+    }
+    return true;
+}
+
+static bool roundTrip(const std::string &name, const std::string &pgn, size_t moves)
+{
+    GameRecord first, second;
+    bool ok = readPgn(pgn, first) && first.chess960 && first.moves.size() == moves;
+    ok = ok && readPgn(writePgn(first), second) && second.chess960 && sameMoves(first, second);
+    std::cout << (ok ? "ok   " : "FAIL ") << name << "\n";
+    return ok;
+}
+
+int main()
+{
+    // Rooks on the b and g files, behind pawns: both castles are legal, and only under Chess960 rules
+    const std::string fen = "[FEN \"1r2k1r1/1p4p1/8/8/8/8/1P4P1/1R2K1R1 w GBgb - 0 1\"]\n";
+    const std::string moves = "\n1. O-O O-O-O 2. Rfe1 Rde8 *\n";
+
+    bool ok = true;
+    ok &= roundTrip("Shredder-FEN, no Variant tag", "[Event \"Test\"]\n" + fen + moves, 4);
+    ok &= roundTrip("Variant Fischerandom", "[Event \"Test\"]\n[Variant \"Fischerandom\"]\n" + fen + moves, 4);
+    ok &= roundTrip("Variant Chess960", "[Event \"Test\"]\n[Variant \"Chess960\"]\n" + fen + moves, 4);
+    ok &= roundTrip("Chess960 setup, no Variant tag",
+                    "[FEN \"bqnb1rkr/pp3ppp/3ppn2/2p5/5P2/P2P4/NPP1P1PP/BQ1BNRKR w HFhf - 2 9\"]\n\n"
+                    "1. Nf3 Nb6 *\n",
+                    2);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "variants/Variant.h"
+
+// Replays the same games through every board implementation and reports
+// time per move and checkmate/stalemate detection latency.
+// Usage: variant_bench [repetitions]
+
+// Games avoid promotions, since the older versions ask for the piece on stdin
+static const std::vector<std::vector<std::string>> games = {
+    {"E2E4", "E7E5", "F1C4", "B8C6", "D1H5", "G8F6", "H5F7"},
+    {"E2E4", "E7E5", "G1F3", "B8C6", "F1C4", "F8C5", "C2C3", "G8F6", "D2D4", "E5D4", "C3D4", "C5B4",
+     "B1C3", "F6E4", "D1B3", "D7D5", "C4D5", "D8D5", "B3D5", "E4C3", "B2C3", "B4C3"},
+    {"A2A4", "H7H5", "A1A3", "H8H6", "A3D3", "H6D6", "D3D6", "E7D6", "B2B4", "G7G5"},
+};
+
+int main(int argc, char *argv[])
+{
+    int repetitions = (argc > 1) ? std::atoi(argv[1]) : 200;
+    std::vector<std::unique_ptr<Variant>> variants = makeVariants();
+
+    std::cout << std::left << std::setw(32) << "Variant" << std::right << std::setw(10) << "Accepted"
+              << std::setw(14) << "ns/move" << std::setw(16) << "us/mate check" << "\n";
+
+    for (auto &v : variants)
+    {
+        int accepted = 0, attempted = 0;
+        long long moveNs = 0, mateNs = 0, mateChecks = 0;
+
+        for (int r = 0; r < repetitions; ++r)
+        {
+            for (const std::vector<std::string> &game : games)
+            {
+                v->reset();
+                bool white = true;
+                for (const std::string &m : game)
+                {
+                    int sx = 8 - (m[1] - '0'), sy = m[0] - 'A';
+                    int ex = 8 - (m[3] - '0'), ey = m[2] - 'A';
+
+                    auto start = std::chrono::steady_clock::now();
+                    bool ok = v->move(sx, sy, ex, ey, white);
+                    moveNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+                    if (r == 0)
+                    {
+                        ++attempted;
+                        if (ok) ++accepted;
+                    }
+                    // Keep replaying the game even where an older version rejects a move
+                    white = !white;
+
+                    if (v->hasMateCheck())
+                    {
+                        start = std::chrono::steady_clock::now();
+                        bool over = v->mateCheck(white);
+                        mateNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                        ++mateChecks;
+                        (void)over;
+                    }
+                }
+            }
+        }
+
+        long long totalMoves = (long long)attempted * repetitions;
+        std::cout << std::left << std::setw(32) << v->name() << std::right << std::setw(6) << accepted << "/"
+                  << std::setw(3) << attempted << std::setw(14) << moveNs / std::max(1LL, totalMoves);
+        if (mateChecks > 0) std::cout << std::setw(16) << std::fixed << std::setprecision(2) << mateNs / 1000.0 / mateChecks;
+        else std::cout << std::setw(16) << "-";
+        std::cout << "\n";
+    }
+    return 0;
+}
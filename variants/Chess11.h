@@ -0,0 +1,101 @@
+#ifndef CHESS11_H
+#define CHESS11_H
+
+#include <iostream>
+#include <vector>
+
+// Earlier version of the board from Chess11.cpp, kept for the variant benchmark
+namespace chess11
+{
+using namespace std;
+
+const int BOARD_SIZE = 8;
+
+enum PieceType { EMPTY, ROOK, PAWN };
+
+// A chess piece is a small value stored directly in the board.
+// isValidMove switches on the type instead of going through a virtual call.
+struct Piece {
+    PieceType type;
+    bool isWhite; // true for white, false for black
+
+    Piece(PieceType type = EMPTY, bool isWhite = false) : type(type), isWhite(isWhite) {}
+
+    bool isEmpty() const {
+        return type == EMPTY;
+    }
+
+    char symbol() const {
+        static const char symbols[] = {'.', 'R', 'P'};
+        return symbols[type];
+    }
+
+    bool isValidMove(int startX, int startY, int endX, int endY) const {
+        switch (type) {
+        case ROOK:
+            // Rooks move horizontally or vertically
+            return (startX == endX || startY == endY);
+        case PAWN: {
+            // Pawns can move forward one square (two squares on their first move)
+            int direction = isWhite ? 1 : -1; // White pawns move up, black pawns move down
+            return startY == endY && (endX == startX + direction || (startX == 1 && endX == startX + 2 * direction));
+        }
+        default:
+            return false;
+        }
+    }
+};
+
+// Chessboard class
+class Chessboard {
+public:
+    Piece board[BOARD_SIZE][BOARD_SIZE]; // Pieces stored inline, so copying the board is a plain copy
+
+    Chessboard() {
+        // Every square starts empty through Piece's default constructor
+
+        // Set up the board with pieces
+        for (int i = 0; i < BOARD_SIZE; ++i) {
+            board[1][i] = Piece(PAWN, true);   // White pawns on the second row
+            board[6][i] = Piece(PAWN, false);  // Black pawns on the second to last row
+        }
+
+        board[0][0] = board[0][7] = Piece(ROOK, true);  // White rooks
+        board[7][0] = board[7][7] = Piece(ROOK, false); // Black rooks
+    }
+
+    void display() {
+        // Print the board
+        for (int i = 0; i < BOARD_SIZE; ++i) {
+            for (int j = 0; j < BOARD_SIZE; ++j) {
+                cout << board[i][j].symbol() << " ";
+            }
+            cout << endl;
+        }
+    }
+
+    bool movePiece(int startX, int startY, int endX, int endY) {
+        if (startX < 0 || startX >= BOARD_SIZE || startY < 0 || startY >= BOARD_SIZE || endX < 0 || endX >= BOARD_SIZE || endY < 0 || endY >= BOARD_SIZE)
+            return false;
+
+        const Piece &piece = board[startX][startY];
+        if (piece.isEmpty())
+            return false;
+
+        if (!board[endX][endY].isEmpty() && board[endX][endY].isWhite == piece.isWhite) {
+            return false; // Can't capture your own piece
+        }
+
+        if (piece.isValidMove(startX, startY, endX, endY)) {
+            board[endX][endY] = piece;
+            board[startX][startY] = Piece();
+            return true;
+        }
+
+        return false;
+    }
+};
+
+} // namespace chess11
+
+#endif
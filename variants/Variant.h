@@ -0,0 +1,35 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Common interface over the board implementations this project has gone through,
+// so the same games can be replayed through each of them.
+// Squares use the current game's coordinates: row 0 is rank 8, column 0 is file A.
+class Variant
+{
+public:
+    virtual ~Variant() {}
+
+    virtual std::string name() = 0;
+    virtual void reset() = 0;
+    virtual bool move(int sx, int sy, int ex, int ey, bool white) = 0;
+
+    // Checkmate/stalemate detection, for the versions that have it
+    virtual bool hasMateCheck()
+    {
+        return false;
+    }
+
+    virtual bool mateCheck(bool white)
+    {
+        (void)white;
+        return false;
+    }
+};
+
+std::vector<std::unique_ptr<Variant>> makeVariants();
+
+#endif
@@ -0,0 +1,177 @@
+#include "Variant.h"
+#include "../Board.h"
+#include "FullMissingEnPassant.h"
+#include "NeedsCheckLimitFix.h"
+#include "ChessVersion3.h"
+#include "Chess11.h"
+
+// Chess1.cpp: a plain char table[8][8], one letter per square and no move rules
+class TableVariant : public Variant
+{
+private:
+    char table[8][8];
+
+public:
+    TableVariant()
+    {
+        reset();
+    }
+
+    std::string name() override
+    {
+        return "Chess1 (char table)";
+    }
+
+    void reset() override
+    {
+        std::string backRank = "RNBQKBNR";
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 8; ++j) table[i][j] = ' ';
+        for (int i = 0; i < 8; ++i)
+        {
+            table[0][i] = tolower(backRank[i]);
+            table[1][i] = 'p';
+            table[6][i] = 'P';
+            table[7][i] = backRank[i];
+        }
+    }
+
+    bool move(int sx, int sy, int ex, int ey, bool white) override
+    {
+        char p = table[sx][sy];
+        if (p == ' ' || (isupper(p) != 0) != white) return false;
+        if (table[ex][ey] != ' ' && (isupper(table[ex][ey]) != 0) == white) return false;
+        table[ex][ey] = p;
+        table[sx][sy] = ' ';
+        return true;
+    }
+};
+
+// Chess11.cpp: rooks and pawns only, stored inline as value-type pieces.
+// Its rows run the other way (white pawns on row 1), so rows are mirrored.
+class InlineVariant : public Variant
+{
+private:
+    chess11::Chessboard board;
+
+public:
+    std::string name() override
+    {
+        return "Chess11 (inline value pieces)";
+    }
+
+    void reset() override
+    {
+        board = chess11::Chessboard();
+    }
+
+    bool move(int sx, int sy, int ex, int ey, bool white) override
+    {
+        const chess11::Piece &p = board.board[7 - sx][sy];
+        if (p.isEmpty() || p.isWhite != white) return false;
+        return board.movePiece(7 - sx, sy, 7 - ex, ey);
+    }
+};
+
+// The three struct-of-Piece boards share one adapter; T is the Board type
+// and C the matching Color enum of each namespace
+template <typename T, typename C>
+class StructVariant : public Variant
+{
+protected:
+    T board;
+    std::string label;
+
+public:
+    StructVariant(const std::string &l) : label(l) {}
+
+    std::string name() override
+    {
+        return label;
+    }
+
+    void reset() override
+    {
+        board = T();
+    }
+
+    bool move(int sx, int sy, int ex, int ey, bool white) override
+    {
+        return board.movePiece(sx, sy, ex, ey, static_cast<C>(white ? 0 : 1));  // WHITE, BLACK in every version
+    }
+};
+
+class Version3Variant : public StructVariant<version3::Board, version3::Color>
+{
+public:
+    Version3Variant() : StructVariant("ChessVersion3 (no check rules)") {}
+};
+
+class CheckLimitVariant : public StructVariant<check_limit_fix::Board, check_limit_fix::Color>
+{
+public:
+    CheckLimitVariant() : StructVariant("NeedsCheckLimitFix") {}
+
+    bool hasMateCheck() override
+    {
+        return true;
+    }
+
+    bool mateCheck(bool white) override
+    {
+        // This version's isCheckmate plays its trial moves on the board itself, so use a copy
+        check_limit_fix::Board temp = board;
+        return temp.isCheckmate(white ? check_limit_fix::WHITE : check_limit_fix::BLACK);
+    }
+};
+
+class MissingEnPassantVariant : public StructVariant<full_missing_en_passant::Board, full_missing_en_passant::Color>
+{
+public:
+    MissingEnPassantVariant() : StructVariant("FullMissingEnPassant") {}
+
+    bool hasMateCheck() override
+    {
+        return true;
+    }
+
+    bool mateCheck(bool white) override
+    {
+        full_missing_en_passant::Color turn = white ? full_missing_en_passant::WHITE : full_missing_en_passant::BLACK;
+        return board.isCheckmate(turn) || board.isStalemate(turn);
+    }
+};
+
+class CurrentVariant : public StructVariant<Board, Color>
+{
+public:
+    CurrentVariant() : StructVariant("Board.h (current)") {}
+
+    bool move(int sx, int sy, int ex, int ey, bool white) override
+    {
+        return board.movePiece(sx, sy, ex, ey, white ? WHITE : BLACK, 'Q');
+    }
+
+    bool hasMateCheck() override
+    {
+        return true;
+    }
+
+    bool mateCheck(bool white) override
+    {
+        Color turn = white ? WHITE : BLACK;
+        return board.isCheckmate(turn) || board.isStalemate(turn);
+    }
+};
+
+std::vector<std::unique_ptr<Variant>> makeVariants()
+{
+    std::vector<std::unique_ptr<Variant>> variants;
+    variants.emplace_back(new TableVariant());
+    variants.emplace_back(new InlineVariant());
+    variants.emplace_back(new Version3Variant());
+    variants.emplace_back(new CheckLimitVariant());
+    variants.emplace_back(new MissingEnPassantVariant());
+    variants.emplace_back(new CurrentVariant());
+    return variants;
+}